@@ -0,0 +1,288 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date 2024
+ * @author Régis Ruelland <regis.ruelland@laas.fr>
+ *
+ * Benchmark of the controllers, filters, transforms and trigonometric functions.
+ *
+ * Each item processes `BENCH_SAMPLES` samples of a 50 Hz sinus and the results
+ * are printed on the standard output as a JSON document:
+ *
+ *  { "scalar": "float32", "samples": 1000000,
+ *    "results": [ { "name": "Pid::calculate", "ns_per_sample": 5.1 }, ... ] }
+ */
+#include <stdio.h>
+#include <chrono>
+#include <pid.h>
+#include <pr.h>
+#include <rst.h>
+#include <mpc.h>
+#include <deadbeat.h>
+#include <state_space.h>
+#include <observer.h>
+#include <repetitive.h>
+#include <harmonics.h>
+#include <statistics.h>
+#include <decimator.h>
+#include <lms.h>
+#include <fir.h>
+#include <filters.h>
+#include <transform.h>
+#include <trigo.h>
+
+#ifndef BENCH_SAMPLES
+#define BENCH_SAMPLES 1000000
+#endif
+
+#define BENCH_TABLE_SIZE 1024
+
+typedef ot_scalar_t scalar_t;
+
+static scalar_t signal_table[BENCH_TABLE_SIZE];
+static scalar_t angle_table[BENCH_TABLE_SIZE];
+// the results are accumulated here so that the compiler can not drop the computations.
+static volatile scalar_t sink;
+static bool first_result = true;
+
+/**
+ * @brief run `step(k)` for BENCH_SAMPLES values of k and print the time by sample.
+ */
+template <typename F>
+static void bench(const char *name, F step) {
+    scalar_t accumulator = 0.0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t k = 0; k < BENCH_SAMPLES; k++) {
+        accumulator += step(k % BENCH_TABLE_SIZE);
+    }
+    auto stop = std::chrono::steady_clock::now();
+    sink = accumulator;
+    double ns = std::chrono::duration<double, std::nano>(stop - start).count();
+    printf("%s    { \"name\": \"%s\", \"ns_per_sample\": %.3f }",
+           first_result ? "" : ",\n", name, ns / BENCH_SAMPLES);
+    first_result = false;
+}
+
+template <uint8_t N>
+static void bench_fir(const char *name) {
+    scalar_t coeffs[N];
+    for (uint8_t k = 0; k < N; k++) {
+        coeffs[k] = 1.0 / N;
+    }
+    ot::Fir<scalar_t> fir;
+    fir.init(N, coeffs);
+    bench(name, [&](uint32_t k) { return fir.update(signal_table[k]); });
+}
+
+int main(void) {
+    const scalar_t Ts = 100e-6;
+    const scalar_t f0 = 50.0;
+    const scalar_t w0 = 2.0 * ot_pi<scalar_t> * f0;
+    for (uint32_t k = 0; k < BENCH_TABLE_SIZE; k++) {
+        angle_table[k] = ot_modulo_2pi(w0 * Ts * k);
+        signal_table[k] = ot_sin(angle_table[k]);
+    }
+
+    printf("{\n  \"scalar\": \"%s\",\n  \"samples\": %u,\n  \"results\": [\n",
+           sizeof(scalar_t) == 4 ? "float32" : "float64", (unsigned)BENCH_SAMPLES);
+
+    ot::Pid<scalar_t> pid(ot::PidParams<scalar_t>(Ts, 1.0, 1e-3, 1e-5, 10.0, -10.0, 10.0));
+    bench("Pid::calculate", [&](uint32_t k) {
+        return pid.calculateWithReturn(signal_table[k], 0.0);
+    });
+
+    ot::Pr<scalar_t> pr(ot::PrParams<scalar_t>(Ts, 1.0, 100.0, w0, 0.0, -10.0, 10.0));
+    bench("Pr::calculate", [&](uint32_t k) {
+        return pr.calculateWithReturn(signal_table[k], 0.0);
+    });
+
+    const scalar_t R[] = { 0.8914, -1.1521, 0.3732 };
+    const scalar_t S[] = { 0.2, 0.0852, -0.0134, -0.0045, -0.1785, -0.0888 };
+    const scalar_t T[] = { 1.0, -1.3741, 0.4867 };
+    ot::RST<scalar_t> rst;
+    rst.init(ot::RstParams<scalar_t>(Ts, 3, R, 6, S, 3, T, -5.0, 5.0));
+    bench("RST::calculate", [&](uint32_t k) {
+        return rst.calculateWithReturn(signal_table[k], 0.0);
+    });
+
+    ot::FcsMpc<scalar_t> mpc;
+    mpc.init(ot::FcsMpcParams<scalar_t>(Ts, 0.5, 10e-3, 400.0, 0.0, true));
+    bench("FcsMpc::calculate", [&](uint32_t k) {
+        ot::clarke_t<scalar_t> reference(10.0 * signal_table[k], 0.0, 0.0);
+        ot::FcsMpcMeasure<scalar_t> measure{};
+        measure.currents.a = signal_table[k];
+        return mpc.calculateWithReturn(reference, measure);
+    });
+
+    ot::Deadbeat<scalar_t> deadbeat;
+    deadbeat.init(ot::DeadbeatParams<scalar_t>(Ts, 0.5, 10e-3, w0, 230.0, true));
+    bench("Deadbeat::calculate", [&](uint32_t k) {
+        ot::dqo_t<scalar_t> reference(10.0 * signal_table[k], 0.0, 0.0);
+        ot::DeadbeatMeasure<scalar_t> measure{};
+        measure.current.d = signal_table[k];
+        return deadbeat.calculateWithReturn(reference, measure).d;
+    });
+
+    ot::StateSpaceParams<4, 2, 2, scalar_t> ss_params{};
+    ss_params.Ts = Ts;
+    for (uint8_t i = 0; i < 4; i++) {
+        for (uint8_t j = 0; j < 4; j++) {
+            ss_params.A[i][j] = (i == j) ? 0.9 : 0.01;
+        }
+        for (uint8_t j = 0; j < 2; j++) {
+            ss_params.Br[i][j] = 0.1;
+            ss_params.By[i][j] = -0.1;
+            ss_params.Bu[i][j] = 0.05;
+            ss_params.C[j][i] = 0.5;
+        }
+    }
+    ss_params.lower_bound = {-10.0, -10.0};
+    ss_params.upper_bound = {10.0, 10.0};
+    ot::StateSpace<4, 2, 2, scalar_t> state_space;
+    state_space.init(ss_params);
+    bench("StateSpace<4, 2, 2>::calculate", [&](uint32_t k) {
+        return state_space.calculateWithReturn({signal_table[k], 0.0}, {0.0, signal_table[k]})[0];
+    });
+
+    ot::ObserverModel<2, 1, 1, scalar_t> observer_model{};
+    observer_model.Ts = Ts;
+    observer_model.A[0][0] = 0.99;
+    observer_model.A[0][1] = -0.1;
+    observer_model.A[1][0] = 5.0;
+    observer_model.A[1][1] = 0.5;
+    observer_model.B[0][0] = 0.1;
+    observer_model.C[0][1] = 1.0;
+    observer_model.Q[0][0] = 1e-4;
+    observer_model.Q[1][1] = 1e-4;
+    observer_model.R[0][0] = 1.0;
+    ot::Observer<2, 1, 1, scalar_t> observer;
+    observer.init(observer_model);
+    bench("Observer<2, 1, 1>::update", [&](uint32_t k) {
+        return observer.update({signal_table[k]}, {signal_table[k]})[0];
+    });
+
+    static scalar_t repetitive_buffer[256];
+    ot::Repetitive<scalar_t> repetitive;
+    repetitive.init(ot::RepetitiveParams<scalar_t>(Ts, 1.0, 0.5, w0, 0.1, 1, -10.0, 10.0,
+                                                   repetitive_buffer, 256));
+    bench("Repetitive::calculate", [&](uint32_t k) {
+        return repetitive.calculateWithReturn(signal_table[k], 0.0);
+    });
+
+    bench_fir<4>("Fir<4>::update");
+    bench_fir<16>("Fir<16>::update");
+    bench_fir<64>("Fir<64>::update");
+
+    scalar_t compensator[3];
+    ot::Decimator<scalar_t>::compensator(3, compensator);
+    ot::Decimator<scalar_t> decimator;
+    decimator.init(ot::DecimatorParams<scalar_t>(8, 3, 3, compensator, 2));
+    scalar_t decimated = 0.0;
+    bench("Decimator(CIC 8x3, Fir 3 / 2)::process by input sample", [&](uint32_t k) {
+        int32_t adc = static_cast<int32_t>(2048.0 * signal_table[k]);
+        decimator.process(&adc, 1, &decimated);
+        return decimated;
+    });
+
+    ot::LmsFilter<16, scalar_t> lms;
+    lms.init(ot::LmsParams<scalar_t>(0.01));
+    bench("LmsFilter<16>::update", [&](uint32_t k) {
+        return lms.update(signal_table[k], signal_table[k ^ 1]);
+    });
+    ot::NlmsFilter<16, scalar_t> nlms;
+    nlms.init(ot::LmsParams<scalar_t>(0.1));
+    bench("NlmsFilter<16>::update", [&](uint32_t k) {
+        return nlms.update(signal_table[k], signal_table[k ^ 1]);
+    });
+
+    ot::NotchFilter<scalar_t> notch;
+    notch.init(Ts, 2.0 * f0, 10.0);
+    bench("NotchFilter::calculateWithReturn", [&](uint32_t k) {
+        return notch.calculateWithReturn(signal_table[k]);
+    });
+    bench("NotchFilter::setF0 + calculateWithReturn", [&](uint32_t k) {
+        notch.setF0(2.0 * f0 + signal_table[k]);
+        return notch.calculateWithReturn(signal_table[k]);
+    });
+
+    static scalar_t statistics_window[1000];
+    ot::MovingStatistics<scalar_t> statistics;
+    statistics.init(statistics_window, 1000);
+    bench("MovingStatistics<1000>::calculateWithReturn", [&](uint32_t k) {
+        return statistics.calculateWithReturn(signal_table[k]);
+    });
+
+    ot::LowPassFirstOrderFilter<scalar_t> lowpass(Ts, 1e-3);
+    bench("LowPassFirstOrderFilter::calculateWithReturn", [&](uint32_t k) {
+        return lowpass.calculateWithReturn(signal_table[k]);
+    });
+
+    ot::PllSinus<scalar_t> pll_sinus;
+    pll_sinus.init(Ts, 1.0, f0, 0.02);
+    bench("PllSinus::calculateWithReturn", [&](uint32_t k) {
+        return pll_sinus.calculateWithReturn(signal_table[k]).w;
+    });
+
+    ot::PllAngle<scalar_t> pll_angle(Ts, f0, 0.02);
+    bench("PllAngle::calculateWithReturn", [&](uint32_t k) {
+        return pll_angle.calculateWithReturn(angle_table[k]).w;
+    });
+
+    const uint8_t orders[] = {1, 3, 5, 7, 9, 11, 13};
+    ot::HarmonicAnalyzer<scalar_t> analyzer;
+    analyzer.init(Ts, orders, 7);
+    bench("HarmonicAnalyzer::update (7 harmonics)", [&](uint32_t k) {
+        analyzer.update(signal_table[k], angle_table[k]);
+        return signal_table[k];
+    });
+
+    typedef ot::Transform<scalar_t> Transform;
+    bench("Transform::clarke", [&](uint32_t k) {
+        ot::three_phase_t<scalar_t> x(signal_table[k], -signal_table[k], 0.0);
+        return Transform::clarke(x).alpha;
+    });
+    bench("Transform::clarke_inverse", [&](uint32_t k) {
+        ot::clarke_t<scalar_t> x(signal_table[k], -signal_table[k], 0.0);
+        return Transform::clarke_inverse(x).a;
+    });
+    bench("Transform::rotation_to_dqo", [&](uint32_t k) {
+        ot::clarke_t<scalar_t> x(signal_table[k], -signal_table[k], 0.0);
+        return Transform::rotation_to_dqo(x, angle_table[k]).d;
+    });
+    bench("Transform::rotation_to_clarke", [&](uint32_t k) {
+        ot::dqo_t<scalar_t> x(signal_table[k], -signal_table[k], 0.0);
+        return Transform::rotation_to_clarke(x, angle_table[k]).alpha;
+    });
+    bench("Transform::to_dqo", [&](uint32_t k) {
+        ot::three_phase_t<scalar_t> x(signal_table[k], -signal_table[k], 0.0);
+        return Transform::to_dqo(x, angle_table[k]).d;
+    });
+    bench("Transform::to_threephase", [&](uint32_t k) {
+        ot::dqo_t<scalar_t> x(signal_table[k], -signal_table[k], 0.0);
+        return Transform::to_threephase(x, angle_table[k]).a;
+    });
+
+    bench("ot_sin", [&](uint32_t k) { return ot_sin(angle_table[k]); });
+    bench("ot_cos", [&](uint32_t k) { return ot_cos(angle_table[k]); });
+    bench("ot_modulo_2pi", [&](uint32_t k) { return ot_modulo_2pi(angle_table[k] + 10.0); });
+
+    printf("\n  ]\n}\n");
+    return 0;
+}
@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date 2024
+ * @author Régis Ruelland <regis.ruelland@laas.fr>
+ *
+ * Host shim of the part of CMSIS-DSP used by the library, based on libm.
+ */
+#ifndef ARM_MATH_H_
+#define ARM_MATH_H_
+#include <math.h>
+#include "arm_math_types.h"
+
+#define PI 3.14159265358979f
+
+static inline float32_t arm_sin_f32(float32_t x) {
+    return sinf(x);
+}
+
+static inline float32_t arm_cos_f32(float32_t x) {
+    return cosf(x);
+}
+
+#endif
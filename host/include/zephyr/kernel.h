@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date 2024
+ * @author Régis Ruelland <regis.ruelland@laas.fr>
+ *
+ * Host shim of the Zephyr threads used by the tests, based on std::thread.
+ */
+#ifndef ZEPHYR_KERNEL_H_
+#define ZEPHYR_KERNEL_H_
+#include <stdint.h>
+#include <stddef.h>
+#include <thread>
+
+#define K_THREAD_STACK_DEFINE(name, size) static char name[size]
+#define K_THREAD_STACK_SIZEOF(stack) sizeof(stack)
+#define K_PRIO_PREEMPT(prio) (prio)
+#define K_NO_WAIT 0
+#define K_FOREVER -1
+
+struct k_thread {
+    std::thread thread;
+};
+
+typedef void (*k_thread_entry_t)(void *, void *, void *);
+
+static inline k_thread *k_thread_create(k_thread *new_thread, char *, size_t,
+                                        k_thread_entry_t entry,
+                                        void *p1, void *p2, void *p3,
+                                        int, uint32_t, int) {
+    new_thread->thread = std::thread(entry, p1, p2, p3);
+    return new_thread;
+}
+
+static inline int k_thread_join(k_thread *thread, int) {
+    thread->thread.join();
+    return 0;
+}
+
+static inline void k_yield(void) {
+    std::this_thread::yield();
+}
+
+#endif
@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date 2024
+ * @author Régis Ruelland <regis.ruelland@laas.fr>
+ *
+ * Host shim of the Zephyr logging: errors and warnings go to stderr, the
+ * other levels are dropped.
+ */
+#ifndef ZEPHYR_LOGGING_LOG_H_
+#define ZEPHYR_LOGGING_LOG_H_
+#include <stdio.h>
+
+#define LOG_MODULE_REGISTER(...)
+#define LOG_MODULE_DECLARE(...)
+
+#define LOG_ERR(format, ...) fprintf(stderr, "<err> " format "\n", ##__VA_ARGS__)
+#define LOG_WRN(format, ...) fprintf(stderr, "<wrn> " format "\n", ##__VA_ARGS__)
+#define LOG_INF(...) do {} while (0)
+#define LOG_DBG(...) do {} while (0)
+
+#endif
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date 2024
+ * @author Régis Ruelland <regis.ruelland@laas.fr>
+ *
+ * Host shim of the ztest API used by tests/src, the tests are run by
+ * ztest_main.cpp. A failed `zassert_*` ends the test, a failed `zexpect_*`
+ * does not.
+ */
+#ifndef ZEPHYR_ZTEST_H_
+#define ZEPHYR_ZTEST_H_
+#include <stdio.h>
+#include <math.h>
+#include <errno.h>
+
+struct ztest_suite {
+    const char *name;
+    void *(*setup)(void);
+    void (*before)(void *);
+    void *fixture;
+    bool ready;
+    ztest_suite *next;
+};
+
+struct ztest_test {
+    const char *suite;
+    const char *name;
+    void (*test)(void *);
+    ztest_test *next;
+};
+
+void ztest_register_suite(ztest_suite *suite);
+void ztest_register_test(ztest_test *test);
+void ztest_fail(const char *file, int line);
+
+#define ZTEST_SUITE(suite, predicate, setup, before, after, teardown) \
+    static ztest_suite ztest_suite_##suite = {#suite, setup, before, nullptr, false, nullptr}; \
+    static int ztest_suite_registered_##suite = (ztest_register_suite(&ztest_suite_##suite), 0)
+
+#define ZTEST(suite, name) \
+    static void suite##_##name(void *); \
+    static ztest_test ztest_test_##suite##_##name = {#suite, #name, suite##_##name, nullptr}; \
+    static int ztest_test_registered_##suite##_##name = \
+        (ztest_register_test(&ztest_test_##suite##_##name), 0); \
+    static void suite##_##name([[maybe_unused]] void *fixture)
+
+#define ZTEST_F(suite, name) ZTEST(suite, name)
+
+#define ZTEST_CHECK(cond, on_failure, ...) do { \
+        if (!(cond)) { \
+            ztest_fail(__FILE__, __LINE__); \
+            __VA_OPT__(printf(__VA_ARGS__);) \
+            printf("\n"); \
+            on_failure; \
+        } \
+    } while (0)
+
+#define zexpect_true(cond, ...) ZTEST_CHECK(cond, , __VA_ARGS__)
+#define zassert_true(cond, ...) ZTEST_CHECK(cond, return, __VA_ARGS__)
+#define zexpect_false(cond, ...) zexpect_true(!(cond), __VA_ARGS__)
+#define zassert_false(cond, ...) zassert_true(!(cond), __VA_ARGS__)
+#define zexpect_equal(a, b, ...) zexpect_true((a) == (b), __VA_ARGS__)
+#define zassert_equal(a, b, ...) zassert_true((a) == (b), __VA_ARGS__)
+#define zexpect_ok(a, ...) zexpect_true((a) == 0, __VA_ARGS__)
+#define zassert_ok(a, ...) zassert_true((a) == 0, __VA_ARGS__)
+#define zexpect_not_null(p, ...) zexpect_true((p) != nullptr, __VA_ARGS__)
+#define zassert_not_null(p, ...) zassert_true((p) != nullptr, __VA_ARGS__)
+#define zexpect_is_null(p, ...) zexpect_true((p) == nullptr, __VA_ARGS__)
+#define zassert_is_null(p, ...) zassert_true((p) == nullptr, __VA_ARGS__)
+#define zexpect_within(a, b, delta, ...) \
+    zexpect_true(fabs((double)(a) - (double)(b)) <= (double)(delta), __VA_ARGS__)
+#define zassert_within(a, b, delta, ...) \
+    zassert_true(fabs((double)(a) - (double)(b)) <= (double)(delta), __VA_ARGS__)
+#define zexpect_between_inclusive(a, lower, upper, ...) \
+    zexpect_true((a) >= (lower) && (a) <= (upper), __VA_ARGS__)
+#define zassert_between_inclusive(a, lower, upper, ...) \
+    zassert_true((a) >= (lower) && (a) <= (upper), __VA_ARGS__)
+
+#endif
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date 2024
+ * @author Régis Ruelland <regis.ruelland@laas.fr>
+ *
+ * Runs the ztest suites of tests/src on the host.
+ */
+#include <string.h>
+#include <zephyr/ztest.h>
+
+static ztest_suite *suites = nullptr;
+static ztest_test *tests = nullptr;
+static int failures = 0;
+
+void ztest_register_suite(ztest_suite *suite) {
+    suite->next = suites;
+    suites = suite;
+}
+
+void ztest_register_test(ztest_test *test) {
+    test->next = tests;
+    tests = test;
+}
+
+void ztest_fail(const char *file, int line) {
+    failures++;
+    printf("    assertion failed at %s:%d: ", file, line);
+}
+
+int main(void) {
+    int count = 0;
+    int failed = 0;
+    for (ztest_test *test = tests; test != nullptr; test = test->next) {
+        void *fixture = nullptr;
+        for (ztest_suite *suite = suites; suite != nullptr; suite = suite->next) {
+            if (strcmp(suite->name, test->suite) == 0) {
+                // the setup is run once by suite
+                if (!suite->ready && suite->setup != nullptr) {
+                    suite->fixture = suite->setup();
+                }
+                suite->ready = true;
+                fixture = suite->fixture;
+                if (suite->before != nullptr) {
+                    suite->before(fixture);
+                }
+            }
+        }
+        int previous_failures = failures;
+        test->test(fixture);
+        count++;
+        if (failures != previous_failures) {
+            failed++;
+        }
+        printf("%s - %s.%s\n", failures == previous_failures ? "PASS" : "FAIL",
+               test->suite, test->name);
+    }
+    printf("%d tests, %d failed\n", count, failed);
+    return failed == 0 ? 0 : 1;
+}
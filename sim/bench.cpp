@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date 2024
+ * @author Régis Ruelland <regis.ruelland@laas.fr>
+ *
+ * Throughput of the closed loop simulation, printed as JSON like the
+ * benchmark of the library.
+ */
+#include <stdio.h>
+#include <chrono>
+#include <pid.h>
+#include <pr.h>
+#include <simulation.h>
+#include <sweep.h>
+#include <fft_fir.h>
+
+#ifndef SIM_BENCH_STEPS
+#define SIM_BENCH_STEPS 20000000
+#endif
+
+static volatile float32_t sink;
+static bool first_result = true;
+
+template <typename F>
+static void bench(const char *name, F run, uint32_t steps = SIM_BENCH_STEPS) {
+    auto start = std::chrono::steady_clock::now();
+    sink = run(steps);
+    auto stop = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(stop - start).count();
+    printf("%s    { \"name\": \"%s\", \"steps_per_second\": %.0f }",
+           first_result ? "" : ",\n", name, steps / seconds);
+    first_result = false;
+}
+
+int main(void) {
+    const float32_t Ts = 50e-6F;
+    printf("{\n  \"steps\": %u,\n  \"results\": [\n", (unsigned)SIM_BENCH_STEPS);
+
+    bench("Pid + RlLoad", [&](uint32_t steps) {
+        ot::sim::RlLoad<float32_t> rl(Ts, 1.0F, 1e-3F);
+        Pid pid(PidParams(Ts, 5.0F, 1e-3F, 0.0F, 0.0F, -100.0F, 100.0F));
+        ot::sim::closedLoop(steps, pid, rl, [](uint32_t k) { return (k & 0x4000) ? 1.0F : -1.0F; });
+        return rl.output();
+    });
+
+    bench("Pid + Buck<Euler>", [&](uint32_t steps) {
+        ot::sim::Buck<float32_t, ot::sim::Euler> buck(Ts, 24.0F, 1e-3F, 100e-6F, 10.0F);
+        Pid pid(PidParams(Ts, 0.01F, 1e-3F, 0.0F, 0.0F, 0.0F, 1.0F));
+        ot::sim::closedLoop(steps, pid, buck, [](uint32_t) { return 12.0F; });
+        return buck.output();
+    });
+
+    bench("Pid + Buck<Rk4>", [&](uint32_t steps) {
+        ot::sim::Buck<float32_t> buck(Ts, 24.0F, 1e-3F, 100e-6F, 10.0F);
+        Pid pid(PidParams(Ts, 0.01F, 1e-3F, 0.0F, 0.0F, 0.0F, 1.0F));
+        ot::sim::closedLoop(steps, pid, buck, [](uint32_t) { return 12.0F; });
+        return buck.output();
+    });
+
+    bench("Pr + LcFilter<Rk4>", [&](uint32_t steps) {
+        ot::sim::LcFilter<float32_t> lc(Ts, 1e-3F, 10e-6F, 0.1F);
+        Pr pr(PrParams(Ts, 0.01F, 10.0F, 2.0F * PI * 50.0F, 0.0F, -50.0F, 50.0F));
+        ot::sim::closedLoop(steps, pr, lc, [&](uint32_t k) { return 10.0F * ot_sin(ot_modulo_2pi(2.0F * PI * 50.0F * Ts * k)); });
+        return lc.output();
+    });
+
+    // a sweep of Pid gains on a Buck, to check the scaling with the threads
+    std::vector<PidParams> params;
+    for (int k = 1; k <= 256; k++) {
+        params.push_back(PidParams(Ts, 0.0002F * k, 1e-3F, 0.0F, 0.0F, 0.0F, 1.0F));
+    }
+    auto buck_step = [&](const PidParams &p) {
+        ot::sim::Buck<float32_t> buck(Ts, 24.0F, 1e-3F, 100e-6F, 10.0F);
+        Pid pid(p);
+        ot::sim::StepMetrics<float32_t> metrics(Ts, 12.0F, 0.0F, 1.0F);
+        ot::sim::closedLoop(SIM_BENCH_STEPS / params.size(), pid, buck,
+                            [](uint32_t) { return 12.0F; }, metrics);
+        return metrics.result();
+    };
+    bench("sweep Pid + Buck<Rk4>, 1 thread", [&](uint32_t) {
+        return ot::sim::sweep(params, buck_step, 1)[0].ise;
+    });
+    bench("sweep Pid + Buck<Rk4>, all threads", [&](uint32_t) {
+        return ot::sim::sweep(params, buck_step)[0].ise;
+    });
+
+    // a long FIR on a capture, directly and by overlap-save
+    const size_t taps = 4096;
+    std::vector<float64_t> coeffs(taps), samples(SIM_BENCH_STEPS / 100);
+    for (size_t k = 0; k < taps; k++) {
+        coeffs[k] = 1.0 / taps;
+    }
+    for (size_t k = 0; k < samples.size(); k++) {
+        samples[k] = (k & 0x400) ? 1.0 : -1.0;
+    }
+    bench("FftFir 4096 taps direct", [&](uint32_t) {
+        ot::sim::FftFir<float64_t> fir(coeffs.data(), taps, ot::sim::FftFir<float64_t>::DIRECT);
+        fir.process(samples.data(), samples.size(), samples.data());
+        return samples.back();
+    }, samples.size());
+    bench("FftFir 4096 taps overlap-save", [&](uint32_t) {
+        ot::sim::FftFir<float64_t> fir(coeffs.data(), taps);
+        fir.process(samples.data(), samples.size(), samples.data());
+        return samples.back();
+    }, samples.size());
+    bench("FftFir 4096 taps overlap-save, 1 sample by call", [&](uint32_t) {
+        ot::sim::FftFir<float64_t> fir(coeffs.data(), taps);
+        for (size_t k = 0; k < samples.size(); k++) {
+            fir.process(&samples[k], 1, &samples[k]);
+        }
+        return samples.back();
+    }, samples.size());
+
+    printf("\n  ]\n}\n");
+    return 0;
+}
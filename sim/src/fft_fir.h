@@ -0,0 +1,289 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date 2024
+ * @author Régis Ruelland <regis.ruelland@laas.fr>
+ *
+ * Long FIR filters on the host, e.g. to post-process captured waveforms.
+ */
+#ifndef SIM_FFT_FIR_H_
+#define SIM_FFT_FIR_H_
+#include <stddef.h>
+#include <stdint.h>
+#include <math.h>
+#include <vector>
+#include <scalar.h>
+
+namespace ot {
+namespace sim {
+
+/**
+ * @class FftFir
+ * @brief FIR filter of any length: y(n) = sum of coeffs[k] x(n - k), as `Fir`.
+ *
+ * Short filters are computed directly. Long ones use the overlap-save method:
+ * blocks of L samples are filtered by a product in the frequency domain with
+ * FFTs of N = L + nc - 1 points, N being the power of 2 which minimizes the
+ * cost by sample, about 2 N log2(N) / L instead of nc products.
+ *
+ * `process` can be called with any number of samples and gives the same
+ * outputs as a single call, without latency. The samples of a call which
+ * would not pay for the 2 FFTs of a frame, a partial block or the end of one,
+ * are filtered directly from the history kept in the frame: one sample by
+ * call costs nc products, as the direct form, instead of a whole FFT. The
+ * best throughput is with multiples of `blockSize()`.
+ *
+ * @tparam T scalar type
+ */
+template <typename T = float64_t>
+class FftFir {
+public:
+    enum Method : uint8_t {
+        AUTO,
+        DIRECT,
+        FFT,
+    };
+
+    // AUTO filters directly up to this number of coefficients
+    static constexpr size_t DIRECT_MAX_TAPS = 64;
+
+    /**
+     * @param coeffs coefficients, coeffs[0] applying to the last sample
+     * @param nc number of coefficients, > 0
+     * @param method AUTO chooses by the number of coefficients
+     */
+    FftFir(const T *coeffs, size_t nc, Method method = AUTO)
+        : _coeffs(coeffs, coeffs + nc) {
+        _fft = method == FFT || (method == AUTO && nc > DIRECT_MAX_TAPS);
+        if (_fft) {
+            _setupFft();
+        } else {
+            _history.assign(nc, 0.0);
+        }
+        reset();
+    };
+
+    /**
+     * @brief filter `count` samples of `input` in `output` (may be the same).
+     */
+    void process(const T *input, size_t count, T *output) {
+        if (!_fft) {
+            _processDirect(input, count, output);
+            return;
+        }
+        size_t history = _coeffs.size() - 1;
+        size_t block = _n - history;
+        while (count > 0) {
+            size_t take = block - _filled < count ? block - _filled : count;
+            for (size_t k = 0; k < take; k++) {
+                _frame[history + _filled + k] = input[k];
+            }
+            if (take * _coeffs.size() >= _frame_cost) {
+                _filterFrame(_filled + take);
+                for (size_t k = 0; k < take; k++) {
+                    output[k] = _re[history + _filled + k];
+                }
+            } else {
+                _filterPartial(_filled, take, output);
+            }
+            _filled += take;
+            input += take;
+            output += take;
+            count -= take;
+            if (_filled == block) {
+                // the last samples of this block are the history of the next one
+                for (size_t k = 0; k < history; k++) {
+                    _frame[k] = _frame[block + k];
+                }
+                _filled = 0;
+            }
+        }
+    };
+
+    void reset(void) {
+        _history.assign(_history.size(), 0.0);
+        _position = 0;
+        _frame.assign(_frame.size(), 0.0);
+        _filled = 0;
+    };
+
+    bool usesFft(void) const {
+        return _fft;
+    };
+
+    /**
+     * @brief number of samples filtered by each FFT, 1 when filtering directly.
+     */
+    size_t blockSize(void) const {
+        return _fft ? _n - _coeffs.size() + 1 : 1;
+    };
+
+private:
+    void _processDirect(const T *input, size_t count, T *output) {
+        size_t nc = _coeffs.size();
+        for (size_t n = 0; n < count; n++) {
+            _history[_position] = input[n];
+            T sum = 0.0;
+            // coeffs[k] applies to the sample written k steps before
+            size_t index = _position;
+            for (size_t k = 0; k < nc; k++) {
+                sum += _coeffs[k] * _history[index];
+                index = index == 0 ? nc - 1 : index - 1;
+            }
+            output[n] = sum;
+            _position = _position + 1 == nc ? 0 : _position + 1;
+        }
+    };
+
+    /**
+     * @brief direct convolution of `count` samples of the frame from the
+     * `first` of the block, each one preceded by its nc - 1 in the frame.
+     */
+    void _filterPartial(size_t first, size_t count, T *output) {
+        size_t nc = _coeffs.size();
+        for (size_t n = 0; n < count; n++) {
+            const T *x = &_frame[nc - 1 + first + n];
+            T sum = 0.0;
+            for (size_t k = 0; k < nc; k++) {
+                sum += _coeffs[k] * x[-ptrdiff_t(k)];
+            }
+            output[n] = sum;
+        }
+    };
+
+    void _setupFft(void) {
+        size_t nc = _coeffs.size();
+        // the cost by output of each size, 2 FFT of N points for N - nc + 1 outputs
+        size_t n = 2;
+        while (n < 2 * nc) {
+            n *= 2;
+        }
+        size_t best = n;
+        double best_cost = 1e300;
+        for (size_t candidate = n; candidate <= 64 * n && candidate <= (size_t(1) << 24); candidate *= 2) {
+            double cost = candidate * log2(double(candidate)) / double(candidate - nc + 1);
+            if (cost < best_cost) {
+                best_cost = cost;
+                best = candidate;
+            }
+        }
+        _n = best;
+        // in products, as nc by sample for the direct form
+        _frame_cost = size_t(2.0 * _n * log2(double(_n)));
+        _twiddle_re.resize(_n / 2);
+        _twiddle_im.resize(_n / 2);
+        for (size_t k = 0; k < _n / 2; k++) {
+            double angle = -2.0 * M_PI * double(k) / double(_n);
+            _twiddle_re[k] = cos(angle);
+            _twiddle_im[k] = sin(angle);
+        }
+        _frame.assign(_n, 0.0);
+        _re.assign(_n, 0.0);
+        _im.assign(_n, 0.0);
+        // spectrum of the coefficients, with the 1 / N of the inverse transform
+        for (size_t k = 0; k < nc; k++) {
+            _re[k] = _coeffs[k] / T(_n);
+        }
+        _transform(_re, _im, false);
+        _spectrum_re = _re;
+        _spectrum_im = _im;
+    };
+
+    /**
+     * @brief circular convolution of the frame by the coefficients, in _re:
+     * the outputs of the block are valid from nc - 1 to nc - 1 + filled.
+     */
+    void _filterFrame(size_t filled) {
+        size_t end = _coeffs.size() - 1 + filled;
+        for (size_t k = 0; k < _n; k++) {
+            _re[k] = k < end ? _frame[k] : 0.0;
+            _im[k] = 0.0;
+        }
+        _transform(_re, _im, false);
+        for (size_t k = 0; k < _n; k++) {
+            T re = _re[k] * _spectrum_re[k] - _im[k] * _spectrum_im[k];
+            _im[k] = _re[k] * _spectrum_im[k] + _im[k] * _spectrum_re[k];
+            _re[k] = re;
+        }
+        _transform(_re, _im, true);
+    };
+
+    /**
+     * @brief in place radix 2 FFT, without the 1 / N of the inverse.
+     */
+    void _transform(std::vector<T> &re, std::vector<T> &im, bool inverse) {
+        for (size_t i = 1, j = 0; i < _n; i++) {
+            size_t bit = _n >> 1;
+            for (; j & bit; bit >>= 1) {
+                j ^= bit;
+            }
+            j ^= bit;
+            if (i < j) {
+                T t = re[i];
+                re[i] = re[j];
+                re[j] = t;
+                t = im[i];
+                im[i] = im[j];
+                im[j] = t;
+            }
+        }
+        T sign = inverse ? -1.0 : 1.0;
+        for (size_t length = 2; length <= _n; length *= 2) {
+            size_t half = length / 2;
+            size_t step = _n / length;
+            for (size_t start = 0; start < _n; start += length) {
+                for (size_t k = 0; k < half; k++) {
+                    T w_re = _twiddle_re[k * step];
+                    T w_im = sign * _twiddle_im[k * step];
+                    size_t a = start + k;
+                    size_t b = a + half;
+                    T t_re = re[b] * w_re - im[b] * w_im;
+                    T t_im = re[b] * w_im + im[b] * w_re;
+                    re[b] = re[a] - t_re;
+                    im[b] = im[a] - t_im;
+                    re[a] += t_re;
+                    im[a] += t_im;
+                }
+            }
+        }
+    };
+
+    std::vector<T> _coeffs;
+    bool _fft = false;
+    // direct
+    std::vector<T> _history;
+    size_t _position = 0;
+    // overlap-save
+    size_t _n = 0;
+    size_t _frame_cost = 0; // of the 2 FFTs of a frame
+    std::vector<T> _twiddle_re;
+    std::vector<T> _twiddle_im;
+    std::vector<T> _spectrum_re;
+    std::vector<T> _spectrum_im;
+    std::vector<T> _frame; // nc - 1 samples of history then the block
+    size_t _filled = 0; // samples of the block received
+    std::vector<T> _re;
+    std::vector<T> _im;
+};
+
+} // namespace sim
+} // namespace ot
+
+#endif
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date 2024
+ * @author Régis Ruelland <regis.ruelland@laas.fr>
+ *
+ * Fixed step integrators of the plant simulation.
+ *
+ * A plant gives the derivative of its state with
+ * `State derivative(const State &x, const Input &u) const`, the state being a
+ * `std::array<T, N>`. The input is kept constant during a step (zero order hold).
+ */
+#ifndef SIM_INTEGRATORS_H_
+#define SIM_INTEGRATORS_H_
+#include <stddef.h>
+#include <array>
+
+namespace ot {
+namespace sim {
+
+/**
+ * @brief first order explicit Euler: one evaluation of the derivative by step.
+ */
+struct Euler {
+    template <typename P, typename T, size_t N, typename U>
+    static inline void step(const P &plant, std::array<T, N> &x, const U &u, T dt) {
+        std::array<T, N> dx = plant.derivative(x, u);
+        for (size_t k = 0; k < N; k++) {
+            x[k] += dt * dx[k];
+        }
+    };
+};
+
+/**
+ * @brief second order Heun method (explicit trapezoidal rule).
+ */
+struct Heun {
+    template <typename P, typename T, size_t N, typename U>
+    static inline void step(const P &plant, std::array<T, N> &x, const U &u, T dt) {
+        std::array<T, N> k1 = plant.derivative(x, u);
+        std::array<T, N> x1;
+        for (size_t k = 0; k < N; k++) {
+            x1[k] = x[k] + dt * k1[k];
+        }
+        std::array<T, N> k2 = plant.derivative(x1, u);
+        for (size_t k = 0; k < N; k++) {
+            x[k] += (T)0.5 * dt * (k1[k] + k2[k]);
+        }
+    };
+};
+
+/**
+ * @brief classical fourth order Runge-Kutta.
+ */
+struct Rk4 {
+    template <typename P, typename T, size_t N, typename U>
+    static inline void step(const P &plant, std::array<T, N> &x, const U &u, T dt) {
+        const T half_dt = (T)0.5 * dt;
+        std::array<T, N> k1 = plant.derivative(x, u);
+        std::array<T, N> xk;
+        for (size_t k = 0; k < N; k++) {
+            xk[k] = x[k] + half_dt * k1[k];
+        }
+        std::array<T, N> k2 = plant.derivative(xk, u);
+        for (size_t k = 0; k < N; k++) {
+            xk[k] = x[k] + half_dt * k2[k];
+        }
+        std::array<T, N> k3 = plant.derivative(xk, u);
+        for (size_t k = 0; k < N; k++) {
+            xk[k] = x[k] + dt * k3[k];
+        }
+        std::array<T, N> k4 = plant.derivative(xk, u);
+        const T sixth_dt = dt / (T)6.0;
+        for (size_t k = 0; k < N; k++) {
+            x[k] += sixth_dt * (k1[k] + 2 * k2[k] + 2 * k3[k] + k4[k]);
+        }
+    };
+};
+
+} // namespace sim
+} // namespace ot
+
+#endif
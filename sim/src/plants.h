@@ -0,0 +1,375 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date 2024
+ * @author Régis Ruelland <regis.ruelland@laas.fr>
+ *
+ * Discrete time models of the systems controlled by the library, to close
+ * the loop on the host.
+ *
+ * Each plant is sampled at `Ts`: `step(u)` holds the input `u` during `Ts` and
+ * integrates the state with the `Integrator` given as template parameter
+ * (see integrators.h), `output()` gives the measured value.
+ */
+#ifndef SIM_PLANTS_H_
+#define SIM_PLANTS_H_
+#include <math.h>
+#include <array>
+#include <scalar.h>
+#include <trigo.h>
+#include <transform.h>
+#include "integrators.h"
+
+namespace ot {
+namespace sim {
+
+/**
+ * @class RlLoad
+ * @brief series R-L load fed by a voltage, the output is the current.
+ *
+ * The state equation L di/dt = v - R i is discretized exactly (zero order hold):
+ * no integrator is needed.
+ */
+template <typename T = ot_scalar_t>
+class RlLoad {
+public:
+    RlLoad(T Ts, T R, T L) {
+        _a = exp(-R * Ts / L);
+        _b = (1 - _a) / R;
+    };
+
+    inline void step(T voltage) {
+        _current = _a * _current + _b * voltage;
+    };
+
+    inline T output(void) const {
+        return _current;
+    };
+
+    void reset(T current = 0.0) {
+        _current = current;
+    };
+
+private:
+    T _a;
+    T _b;
+    T _current{};
+};
+
+/**
+ * @class LcFilter
+ * @brief L-C output filter with the series resistance of the inductor.
+ *
+ * states: inductor current, capacitor voltage. inputs: voltage applied to the
+ * filter and current drawn by the load (`setLoadCurrent`). The output is the
+ * capacitor voltage.
+ */
+template <typename T = ot_scalar_t, typename Integrator = Rk4>
+class LcFilter {
+public:
+    typedef std::array<T, 2> State;
+
+    LcFilter(T Ts, T L, T C, T R): _Ts(Ts), _inverse_L(1 / L), _inverse_C(1 / C), _R(R) {};
+
+    inline State derivative(const State &x, const T &voltage) const {
+        return State{ _inverse_L * (voltage - x[1] - _R * x[0]),
+                      _inverse_C * (x[0] - _load_current) };
+    };
+
+    inline void step(T voltage) {
+        Integrator::step(*this, _x, voltage, _Ts);
+    };
+
+    inline T output(void) const {
+        return _x[1];
+    };
+
+    inline T current(void) const {
+        return _x[0];
+    };
+
+    void setLoadCurrent(T current) {
+        _load_current = current;
+    };
+
+    void reset(void) {
+        _x = State{};
+    };
+
+private:
+    T _Ts;
+    T _inverse_L;
+    T _inverse_C;
+    T _R;
+    T _load_current{};
+    State _x{};
+};
+
+/**
+ * @class Buck
+ * @brief averaged model of a buck converter on a resistive load.
+ *
+ * states: inductor current, output voltage. input: duty cycle in [0, 1]. The
+ * output is the output voltage.
+ */
+template <typename T = ot_scalar_t, typename Integrator = Rk4>
+class Buck {
+public:
+    typedef std::array<T, 2> State;
+
+    Buck(T Ts, T Vin, T L, T C, T R_load)
+        : _Ts(Ts), _Vin(Vin), _inverse_L(1 / L), _inverse_C(1 / C), _inverse_R(1 / R_load) {};
+
+    inline State derivative(const State &x, const T &duty) const {
+        return State{ _inverse_L * (duty * _Vin - x[1]),
+                      _inverse_C * (x[0] - _inverse_R * x[1]) };
+    };
+
+    inline void step(T duty) {
+        Integrator::step(*this, _x, duty, _Ts);
+    };
+
+    inline T output(void) const {
+        return _x[1];
+    };
+
+    inline T current(void) const {
+        return _x[0];
+    };
+
+    void setInputVoltage(T Vin) {
+        _Vin = Vin;
+    };
+
+    void setLoad(T R_load) {
+        _inverse_R = 1 / R_load;
+    };
+
+    void reset(void) {
+        _x = State{};
+    };
+
+private:
+    T _Ts;
+    T _Vin;
+    T _inverse_L;
+    T _inverse_C;
+    T _inverse_R;
+    State _x{};
+};
+
+/**
+ * @class Boost
+ * @brief averaged model of a boost converter on a resistive load.
+ *
+ * states: inductor current, output voltage. input: duty cycle in [0, 1]. The
+ * output is the output voltage.
+ */
+template <typename T = ot_scalar_t, typename Integrator = Rk4>
+class Boost {
+public:
+    typedef std::array<T, 2> State;
+
+    Boost(T Ts, T Vin, T L, T C, T R_load)
+        : _Ts(Ts), _Vin(Vin), _inverse_L(1 / L), _inverse_C(1 / C), _inverse_R(1 / R_load) {};
+
+    inline State derivative(const State &x, const T &duty) const {
+        T off = 1 - duty;
+        return State{ _inverse_L * (_Vin - off * x[1]),
+                      _inverse_C * (off * x[0] - _inverse_R * x[1]) };
+    };
+
+    inline void step(T duty) {
+        Integrator::step(*this, _x, duty, _Ts);
+    };
+
+    inline T output(void) const {
+        return _x[1];
+    };
+
+    inline T current(void) const {
+        return _x[0];
+    };
+
+    void setInputVoltage(T Vin) {
+        _Vin = Vin;
+    };
+
+    void setLoad(T R_load) {
+        _inverse_R = 1 / R_load;
+    };
+
+    void reset(void) {
+        _x = State{};
+    };
+
+private:
+    T _Ts;
+    T _Vin;
+    T _inverse_L;
+    T _inverse_C;
+    T _inverse_R;
+    State _x{};
+};
+
+/**
+ * @class ThreePhaseGrid
+ * @brief balanced three phase voltage source.
+ *
+ * The amplitude, the frequency and the phase can be changed during a
+ * simulation to test a pll or a grid following controller.
+ */
+template <typename T = ot_scalar_t>
+class ThreePhaseGrid {
+public:
+    ThreePhaseGrid(T Ts, T amplitude, T f0): _Ts(Ts), _amplitude(amplitude) {
+        setFrequency(f0);
+    };
+
+    inline void step(void) {
+        _angle = ot_modulo_2pi(_angle + _w * _Ts);
+    };
+
+    inline three_phase_t<T> output(void) const {
+        const T shift = 2 * ot_pi<T> / 3;
+        return three_phase_t<T>(_amplitude * ot_cos(_angle),
+                                _amplitude * ot_cos(ot_modulo_2pi(_angle - shift)),
+                                _amplitude * ot_cos(ot_modulo_2pi(_angle + shift)));
+    };
+
+    /**
+     * @brief angle of the phase a, in [0, 2pi[
+     */
+    inline T angle(void) const {
+        return _angle;
+    };
+
+    void setAmplitude(T amplitude) {
+        _amplitude = amplitude;
+    };
+
+    void setFrequency(T f0) {
+        _w = 2 * ot_pi<T> * f0;
+    };
+
+    void phaseJump(T phase) {
+        _angle = ot_modulo_2pi(_angle + phase);
+    };
+
+private:
+    T _Ts;
+    T _amplitude;
+    T _w{};
+    T _angle{};
+};
+
+/**
+ * @class Pmsm
+ * @brief permanent magnet synchronous machine in the rotor (d, q) frame.
+ *
+ * states: id, iq, electrical speed, electrical angle. inputs: vd, vq and the
+ * load torque (`setLoadTorque`). The abc quantities use `Transform` with the
+ * electrical angle.
+ */
+template <typename T = ot_scalar_t, typename Integrator = Rk4>
+class Pmsm {
+public:
+    typedef std::array<T, 4> State;
+
+    /**
+     * @param Rs stator resistance
+     * @param Ld d axis inductance
+     * @param Lq q axis inductance
+     * @param psi permanent magnet flux
+     * @param p number of pole pairs
+     * @param J inertia
+     * @param B viscous friction
+     */
+    Pmsm(T Ts, T Rs, T Ld, T Lq, T psi, T p, T J, T B)
+        : _Ts(Ts), _Rs(Rs), _Ld(Ld), _Lq(Lq), _psi(psi), _p(p), _J(J), _B(B) {};
+
+    inline State derivative(const State &x, const dqo_t<T> &v) const {
+        T id = x[0];
+        T iq = x[1];
+        T we = x[2];
+        T torque = electromagneticTorque(id, iq);
+        return State{ (v.d - _Rs * id + we * _Lq * iq) / _Ld,
+                      (v.q - _Rs * iq - we * (_Ld * id + _psi)) / _Lq,
+                      _p * (torque - _B * we / _p - _load_torque) / _J,
+                      we };
+    };
+
+    inline void step(dqo_t<T> v) {
+        Integrator::step(*this, _x, v, _Ts);
+        _x[3] = ot_modulo_2pi(_x[3]);
+    };
+
+    inline void step(three_phase_t<T> v) {
+        step(Transform<T>::to_dqo(v, _x[3]));
+    };
+
+    inline dqo_t<T> output(void) const {
+        return dqo_t<T>(_x[0], _x[1], 0.0);
+    };
+
+    inline three_phase_t<T> currents(void) const {
+        return Transform<T>::to_threephase(output(), _x[3]);
+    };
+
+    inline T electromagneticTorque(T id, T iq) const {
+        return (T)1.5 * _p * (_psi * iq + (_Ld - _Lq) * id * iq);
+    };
+
+    /**
+     * @brief mechanical speed in rad/s
+     */
+    inline T speed(void) const {
+        return _x[2] / _p;
+    };
+
+    inline T angle(void) const {
+        return _x[3];
+    };
+
+    void setLoadTorque(T torque) {
+        _load_torque = torque;
+    };
+
+    void reset(void) {
+        _x = State{};
+    };
+
+private:
+    T _Ts;
+    T _Rs;
+    T _Ld;
+    T _Lq;
+    T _psi;
+    T _p;
+    T _J;
+    T _B;
+    T _load_torque{};
+    State _x{};
+};
+
+} // namespace sim
+} // namespace ot
+
+#endif
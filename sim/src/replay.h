@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date 2024
+ * @author Régis Ruelland <regis.ruelland@laas.fr>
+ *
+ * Replay on the host of the samples recorded by a `Recorder` in the field.
+ *
+ * A recording is the raw stream of `RecordSample<T>` drained from the
+ * recorder (to a file or an uart), as they are in memory: little endian, 16
+ * bytes by sample for float32_t. Each sample is fed to a controller set up like
+ * the recorded one and its output is compared bit for bit with the recorded
+ * output.
+ */
+#ifndef SIM_REPLAY_H_
+#define SIM_REPLAY_H_
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <recorder.h>
+
+namespace ot {
+namespace sim {
+
+struct ReplayResult {
+    uint64_t samples;
+    uint64_t mismatches;
+    uint64_t first_mismatch; // index of the first mismatch, `samples` if none
+};
+
+/**
+ * @brief replays a recording through `step`.
+ *
+ * @param step called with each sample, returns the output to compare to the
+ * recorded one.
+ */
+template <typename T, typename F>
+ReplayResult replay(FILE *recording, F &&step) {
+    static constexpr uint32_t CHUNK = 256;
+    RecordSample<T> samples[CHUNK];
+    ReplayResult result{0, 0, 0};
+    bool mismatch = false;
+    size_t count;
+    while ((count = fread(samples, sizeof(RecordSample<T>), CHUNK, recording)) > 0) {
+        for (size_t k = 0; k < count; k++) {
+            T output = step(samples[k]);
+            if (memcmp(&output, &samples[k].output, sizeof(T)) != 0) {
+                if (!mismatch) {
+                    result.first_mismatch = result.samples;
+                    mismatch = true;
+                }
+                result.mismatches++;
+            }
+            result.samples++;
+        }
+    }
+    if (!mismatch) {
+        result.first_mismatch = result.samples;
+    }
+    return result;
+}
+
+/**
+ * @brief replays a recording of a controller (`Pid`, `Pr`, `RST`, ...)
+ */
+template <typename T, typename C>
+ReplayResult replayController(FILE *recording, C &controller) {
+    return replay<T>(recording, [&](const RecordSample<T> &sample) {
+        return controller.calculateWithReturn(sample.reference, sample.measure);
+    });
+}
+
+/**
+ * @brief replays a recording of a filter (`LowPassFirstOrderFilter`, `NotchFilter`)
+ */
+template <typename T, typename F>
+ReplayResult replayFilter(FILE *recording, F &filter) {
+    return replay<T>(recording, [&](const RecordSample<T> &sample) {
+        return filter.calculateWithReturn(sample.reference);
+    });
+}
+
+/**
+ * @brief replays a recording of a pll, the pulsation is compared.
+ */
+template <typename T, typename P>
+ReplayResult replayPll(FILE *recording, P &pll) {
+    return replay<T>(recording, [&](const RecordSample<T> &sample) {
+        return pll.calculateWithReturn(sample.reference).w;
+    });
+}
+
+} // namespace sim
+} // namespace ot
+
+#endif
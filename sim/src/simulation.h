@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date 2024
+ * @author Régis Ruelland <regis.ruelland@laas.fr>
+ *
+ * Closed loop simulation of a controller of the library with a plant.
+ */
+#ifndef SIM_SIMULATION_H_
+#define SIM_SIMULATION_H_
+#include <stdint.h>
+#include "plants.h"
+
+namespace ot {
+namespace sim {
+
+/**
+ * @brief closes the loop between `controller` and `plant` during `steps` sample times.
+ *
+ * At each step the controller computes its output from `reference(k)` and the
+ * plant output, then the plant is held at this output during one step and
+ * `observe(k, y, u)` is called.
+ *
+ * @param controller has `calculateWithReturn(reference, measure)` (a `Controller`)
+ * @param plant has `output()` and `step(u)`
+ * @param reference callable giving the reference of the step `k`
+ * @param observe callable receiving the step, the measure and the command, taken
+ * by reference so that it can accumulate results (e.g. `StepMetrics`)
+ */
+template <typename C, typename P, typename R, typename O>
+inline void closedLoop(uint32_t steps, C &controller, P &plant, R &&reference, O &&observe) {
+    for (uint32_t k = 0; k < steps; k++) {
+        auto y = plant.output();
+        auto u = controller.calculateWithReturn(reference(k), y);
+        plant.step(u);
+        observe(k, y, u);
+    }
+}
+
+template <typename C, typename P, typename R>
+inline void closedLoop(uint32_t steps, C &controller, P &plant, R &&reference) {
+    closedLoop(steps, controller, plant, reference, [](uint32_t, auto, auto) {});
+}
+
+} // namespace sim
+} // namespace ot
+
+#endif
@@ -0,0 +1,329 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date 2024
+ * @author Régis Ruelland <regis.ruelland@laas.fr>
+ *
+ * Parallel evaluation of many closed loop runs, to tune a controller.
+ *
+ * `sweep` calls `run(params[k])` for every set of parameters on a work
+ * stealing pool of threads. Each run builds its own controller and plant:
+ * the workers share nothing but the read only parameters and write their
+ * result in their own slot of the result vector. A run usually measures its
+ * step response with `StepMetrics`. `sweepStream` hands each result to a sink,
+ * such as `SweepWriter`, as soon as its run ends.
+ */
+#ifndef SIM_SWEEP_H_
+#define SIM_SWEEP_H_
+#include <stdint.h>
+#include <stdio.h>
+#include <math.h>
+#include <string.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <scalar.h>
+
+namespace ot {
+namespace sim {
+
+/**
+ * @brief figures of merit of a step response.
+ *
+ * @param overshoot maximum of the output beyond the reference, relative to
+ * the step amplitude, 0 for a null step
+ * @param settling_time time after which the output stays within the band
+ * around the reference, negative if it never settles
+ * @param ise integral of the squared error
+ * @param saturation_time time spent with the command on a bound
+ */
+struct RunMetrics {
+    float32_t overshoot;
+    float32_t settling_time;
+    float32_t ise;
+    float32_t saturation_time;
+};
+
+/**
+ * @class StepMetrics
+ * @brief measures a step response from `initial` to `reference`, one sample
+ * at a time.
+ *
+ * It can be given as the observer of `closedLoop`.
+ */
+template <typename T = ot_scalar_t>
+class StepMetrics {
+public:
+    /**
+     * @param Ts sample time
+     * @param reference final value of the step
+     * @param lower_bound lower bound of the command
+     * @param upper_bound upper bound of the command
+     * @param band settling band, relative to the step amplitude
+     * @param initial output before the step
+     */
+    StepMetrics(T Ts, T reference, T lower_bound, T upper_bound, T band = 0.02, T initial = 0)
+        : _Ts(Ts), _reference(reference), _step(reference - initial), _lower_bound(lower_bound),
+          _upper_bound(upper_bound), _band(fabs(band * (reference - initial))), _peak(initial) {};
+
+    inline void add(T y, T u) {
+        T error = _reference - y;
+        _ise += error * error;
+        if (_step >= 0 ? y > _peak : y < _peak) {
+            _peak = y;
+        }
+        if (u <= _lower_bound || u >= _upper_bound) {
+            _saturated_steps++;
+        }
+        if (fabs(error) > _band) {
+            _last_outside = _steps;
+        }
+        _steps++;
+    };
+
+    inline void operator()(uint32_t, T y, T u) {
+        add(y, u);
+    };
+
+    RunMetrics result(void) const {
+        RunMetrics metrics;
+        T overshoot = (_step != 0) ? (_peak - _reference) / _step : 0;
+        metrics.overshoot = overshoot > 0 ? overshoot : 0;
+        metrics.settling_time = (_last_outside + 1 >= _steps) ? -1 : (_last_outside + 1) * _Ts;
+        metrics.ise = _ise * _Ts;
+        metrics.saturation_time = _saturated_steps * _Ts;
+        return metrics;
+    };
+
+private:
+    T _Ts;
+    T _reference;
+    T _step;
+    T _lower_bound;
+    T _upper_bound;
+    T _band;
+    T _peak;
+    T _ise{};
+    uint32_t _steps = 0;
+    int64_t _last_outside = -1;
+    uint32_t _saturated_steps = 0;
+};
+
+/**
+ * @brief calls `task(k)` for k in [0, count[ on `threads` threads.
+ *
+ * Each thread starts with a contiguous part of the indices and takes them one
+ * by one; when it has finished, it steals the second half of the biggest range
+ * left to the other threads, until only single indices remain. `threads` = 0
+ * uses all the cores.
+ */
+template <typename F>
+void parallelFor(uint32_t count, F task, unsigned threads = 0) {
+    if (threads == 0) {
+        threads = std::thread::hardware_concurrency();
+    }
+    if (threads == 0) {
+        threads = 1;
+    }
+    if (threads > count) {
+        threads = count;
+    }
+    if (threads <= 1) {
+        for (uint32_t k = 0; k < count; k++) {
+            task(k);
+        }
+        return;
+    }
+
+    struct alignas(64) Range {
+        std::mutex lock;
+        uint32_t begin;
+        uint32_t end;
+    };
+    std::unique_ptr<Range[]> ranges(new Range[threads]);
+    for (unsigned w = 0; w < threads; w++) {
+        ranges[w].begin = (uint64_t)count * w / threads;
+        ranges[w].end = (uint64_t)count * (w + 1) / threads;
+    }
+
+    auto worker = [&](unsigned w) {
+        Range &own = ranges[w];
+        while (true) {
+            uint32_t index;
+            {
+                std::lock_guard<std::mutex> guard(own.lock);
+                index = own.begin;
+                if (index < own.end) {
+                    own.begin++;
+                }
+            }
+            if (index < own.end) {
+                task(index);
+                continue;
+            }
+            // steal the second half of the biggest range left, a single
+            // index stays to its owner.
+            while (true) {
+                Range *victim = nullptr;
+                uint32_t biggest = 1;
+                for (unsigned v = 1; v < threads; v++) {
+                    Range &range = ranges[(w + v) % threads];
+                    std::lock_guard<std::mutex> guard(range.lock);
+                    if (range.end - range.begin > biggest) {
+                        biggest = range.end - range.begin;
+                        victim = &range;
+                    }
+                }
+                if (victim == nullptr) {
+                    return;
+                }
+                std::scoped_lock guard(own.lock, victim->lock);
+                // the victim may have moved on since it was measured.
+                if (victim->end - victim->begin > 1) {
+                    uint32_t middle = victim->begin + (victim->end - victim->begin + 1) / 2;
+                    own.begin = middle;
+                    own.end = victim->end;
+                    victim->end = middle;
+                    break;
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned w = 1; w < threads; w++) {
+        pool.emplace_back(worker, w);
+    }
+    worker(0);
+    for (std::thread &thread : pool) {
+        thread.join();
+    }
+}
+
+/**
+ * @brief evaluates `run(params[k])` for every set of parameters in parallel.
+ *
+ * @param run returns the RunMetrics of one set of parameters, it must only
+ * modify its own objects.
+ * @return the metrics in the order of `params`.
+ */
+template <typename P, typename F>
+std::vector<RunMetrics> sweep(const std::vector<P> &params, F run, unsigned threads = 0) {
+    std::vector<RunMetrics> results(params.size());
+    parallelFor(params.size(), [&](uint32_t k) { results[k] = run(params[k]); }, threads);
+    return results;
+}
+
+/**
+ * @brief evaluates `run(params[k])` for every set of parameters in parallel
+ * and gives each result to `sink(k, metrics)` as soon as its run ends.
+ *
+ * The calls to `sink` are serialised, in the order in which the runs end, so
+ * a long sweep is written while it runs and nothing is kept in memory.
+ */
+template <typename P, typename F, typename S>
+void sweepStream(const std::vector<P> &params, F run, S &&sink, unsigned threads = 0) {
+    std::mutex lock;
+    parallelFor(params.size(), [&](uint32_t k) {
+        RunMetrics metrics = run(params[k]);
+        std::lock_guard<std::mutex> guard(lock);
+        sink(k, metrics);
+    }, threads);
+}
+
+/**
+ * @class SweepWriter
+ * @brief sink of `sweepStream` which writes the metrics of each run as it ends.
+ *
+ * CSV lines carry the index of their run and come in completion order. The
+ * binary file is the one of `writeBinary`: each run is written in its slot,
+ * which needs a seekable file when the runs end out of order.
+ */
+class SweepWriter {
+public:
+    enum Format {
+        CSV,
+        BINARY
+    };
+
+    /**
+     * @param file output, left open
+     * @param format CSV or BINARY
+     * @param count number of runs of the sweep
+     */
+    SweepWriter(FILE *file, Format format, uint32_t count)
+        : _file(file), _format(format), _base(ftell(file)) {
+        if (format == CSV) {
+            fprintf(file, "run,overshoot,settling_time,ise,saturation_time\n");
+        } else {
+            fwrite("OTSW", 1, 4, file);
+            fwrite(&count, sizeof(count), 1, file);
+        }
+    };
+
+    void operator()(uint32_t k, const RunMetrics &m) {
+        if (_format == CSV) {
+            fprintf(_file, "%u,%g,%g,%g,%g\n", k, m.overshoot, m.settling_time, m.ise,
+                    m.saturation_time);
+            return;
+        }
+        if (k != _next) {
+            fseek(_file, _base + HEADER_SIZE + (long)k * sizeof(RunMetrics), SEEK_SET);
+        }
+        fwrite(&m, sizeof(RunMetrics), 1, _file);
+        _next = k + 1;
+    };
+
+private:
+    static constexpr long HEADER_SIZE = 4 + sizeof(uint32_t);
+    FILE *_file;
+    Format _format;
+    long _base;
+    uint32_t _next = 0;
+};
+
+/**
+ * @brief writes the metrics as CSV, one line by run with its index.
+ */
+inline void writeCsv(FILE *file, const std::vector<RunMetrics> &results) {
+    SweepWriter writer(file, SweepWriter::CSV, results.size());
+    for (uint32_t k = 0; k < results.size(); k++) {
+        writer(k, results[k]);
+    }
+}
+
+/**
+ * @brief writes the metrics in binary: the magic "OTSW", the number of runs
+ * on an uint32_t, then 4 float32_t by run (little endian, in the order of
+ * RunMetrics).
+ */
+inline void writeBinary(FILE *file, const std::vector<RunMetrics> &results) {
+    SweepWriter writer(file, SweepWriter::BINARY, results.size());
+    for (uint32_t k = 0; k < results.size(); k++) {
+        writer(k, results[k]);
+    }
+}
+
+} // namespace sim
+} // namespace ot
+
+#endif
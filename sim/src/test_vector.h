@@ -0,0 +1,353 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date 2024
+ * @author Régis Ruelland <regis.ruelland@laas.fr>
+ *
+ * Binary test vectors: long captured or simulated waveforms replayed through
+ * the controllers without compiling them in the test image.
+ *
+ * A file (usually `*.otv`) is, in little endian:
+ * - the header `TestVectorHeader` (32 bytes): magic "OTVF", format version,
+ *   number of channels, size of a sample (4 for float32_t, 8 for float64_t),
+ *   sample time and number of frames,
+ * - the name of each channel on 16 bytes (nul padded),
+ * - the frames: one sample of each channel, in the order of the names.
+ *
+ * `TestVectorReader` maps the file in memory on the host, and reads it by
+ * chunks of `CHUNK_FRAMES` frames on native_posix (or when asked): the memory
+ * used does not depend on the length of the capture. On a board without file
+ * system, a vector embedded in the image is read in place.
+ */
+#ifndef SIM_TEST_VECTOR_H_
+#define SIM_TEST_VECTOR_H_
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <scalar.h>
+
+#if !defined(__ZEPHYR__) && (defined(__linux__) || defined(__APPLE__))
+#define OT_TEST_VECTOR_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * frames read at once from a file, an image which only reads embedded vectors
+ * can set it to 1.
+ */
+#ifndef OT_TEST_VECTOR_CHUNK_FRAMES
+#define OT_TEST_VECTOR_CHUNK_FRAMES 256
+#endif
+
+namespace ot {
+namespace sim {
+
+static constexpr uint16_t TEST_VECTOR_VERSION = 1;
+static constexpr uint8_t TEST_VECTOR_NAME_SIZE = 16;
+
+struct TestVectorHeader {
+    char magic[4];
+    uint16_t version;
+    uint16_t channels;
+    uint32_t sample_size;
+    uint32_t reserved;
+    float64_t Ts;
+    uint64_t frames;
+};
+static_assert(sizeof(TestVectorHeader) == 32, "the header is part of the file format");
+
+/**
+ * @class TestVectorWriter
+ * @brief writes a test vector frame by frame.
+ *
+ * @tparam T type of the samples
+ */
+template <typename T = ot_scalar_t>
+class TestVectorWriter {
+public:
+    TestVectorWriter() {};
+    TestVectorWriter(const TestVectorWriter &) = delete;
+    TestVectorWriter &operator=(const TestVectorWriter &) = delete;
+
+    ~TestVectorWriter() {
+        close();
+    };
+
+    /**
+     * @brief create the file.
+     *
+     * @param names name of each channel, truncated to 15 characters
+     * @return 0 if ok, -EINVAL or -EIO else.
+     */
+    int8_t open(const char *path, T Ts, uint16_t channels, const char *const *names) {
+        if (channels == 0 || Ts <= 0) {
+            return -EINVAL;
+        }
+        _file = fopen(path, "wb");
+        if (_file == nullptr) {
+            return -EIO;
+        }
+        _header = TestVectorHeader{{'O', 'T', 'V', 'F'}, TEST_VECTOR_VERSION, channels,
+                                   sizeof(T), 0, Ts, 0};
+        fwrite(&_header, sizeof(_header), 1, _file);
+        for (uint16_t k = 0; k < channels; k++) {
+            char name[TEST_VECTOR_NAME_SIZE] = {};
+            strncpy(name, names[k], TEST_VECTOR_NAME_SIZE - 1);
+            fwrite(name, TEST_VECTOR_NAME_SIZE, 1, _file);
+        }
+        return ferror(_file) ? -EIO : 0;
+    };
+
+    /**
+     * @brief append a frame of `channels` samples.
+     */
+    void write(const T *frame) {
+        fwrite(frame, sizeof(T), _header.channels, _file);
+        _header.frames++;
+    };
+
+    /**
+     * @brief write the number of frames in the header and close the file.
+     *
+     * @return 0 if ok, -EIO else.
+     */
+    int8_t close(void) {
+        if (_file == nullptr) {
+            return 0;
+        }
+        fseek(_file, 0, SEEK_SET);
+        fwrite(&_header, sizeof(_header), 1, _file);
+        int8_t error = ferror(_file) ? -EIO : 0;
+        fclose(_file);
+        _file = nullptr;
+        return error;
+    };
+
+private:
+    FILE *_file = nullptr;
+    TestVectorHeader _header{};
+};
+
+/**
+ * @class TestVectorReader
+ * @brief reads a test vector frame by frame.
+ *
+ * @tparam T type of the samples, it must be the one of the file.
+ */
+template <typename T = ot_scalar_t>
+class TestVectorReader {
+public:
+    static constexpr uint32_t CHUNK_FRAMES = OT_TEST_VECTOR_CHUNK_FRAMES;
+    static constexpr uint16_t MAX_CHANNELS = 16;
+
+    TestVectorReader() {};
+    TestVectorReader(const TestVectorReader &) = delete;
+    TestVectorReader &operator=(const TestVectorReader &) = delete;
+
+    ~TestVectorReader() {
+        close();
+    };
+
+    /**
+     * @brief open a test vector.
+     *
+     * @param chunked read by chunks even if the file could be mapped.
+     * @return 0 if ok, -ENOENT if the file can not be opened, -EINVAL if it
+     * is not a test vector of T samples with at most MAX_CHANNELS channels,
+     * -EIO for a truncated file.
+     */
+    int8_t open(const char *path, bool chunked = false) {
+        close();
+        _file = fopen(path, "rb");
+        if (_file == nullptr) {
+            return -ENOENT;
+        }
+        if (fread(&_header, sizeof(_header), 1, _file) != 1) {
+            close();
+            return -EIO;
+        }
+        if (!_valid()) {
+            close();
+            return -EINVAL;
+        }
+        if (fread(_names, TEST_VECTOR_NAME_SIZE, _header.channels, _file) != _header.channels) {
+            close();
+            return -EIO;
+        }
+        _data_offset = sizeof(_header) + TEST_VECTOR_NAME_SIZE * _header.channels;
+        _next = 0;
+#ifdef OT_TEST_VECTOR_MMAP
+        if (!chunked) {
+            return _map();
+        }
+#endif
+        _chunk_begin = 0;
+        _chunk_frames = 0;
+        return 0;
+    };
+
+    /**
+     * @brief read a test vector held in memory, e.g. embedded in the image.
+     *
+     * @param data content of the file, aligned for T, it must outlive the reader.
+     * @return 0 if ok, -EINVAL if it is not a test vector of T samples with at
+     * most MAX_CHANNELS channels, -EIO if it is truncated.
+     */
+    int8_t open(const uint8_t *data, size_t size) {
+        close();
+        if (size < sizeof(_header)) {
+            return -EIO;
+        }
+        memcpy(&_header, data, sizeof(_header));
+        if (!_valid()) {
+            return -EINVAL;
+        }
+        _data_offset = sizeof(_header) + TEST_VECTOR_NAME_SIZE * _header.channels;
+        if (size < _data_offset + _header.frames * _header.channels * sizeof(T)) {
+            return -EIO;
+        }
+        memcpy(_names, data + sizeof(_header), TEST_VECTOR_NAME_SIZE * _header.channels);
+        _frames = reinterpret_cast<const T *>(data + _data_offset);
+        _next = 0;
+        return 0;
+    };
+
+    void close(void) {
+#ifdef OT_TEST_VECTOR_MMAP
+        if (_mapping != nullptr) {
+            munmap(_mapping, _mapping_size);
+            _mapping = nullptr;
+        }
+#endif
+        _frames = nullptr;
+        if (_file != nullptr) {
+            fclose(_file);
+            _file = nullptr;
+        }
+    };
+
+    uint64_t frames(void) const {
+        return _header.frames;
+    };
+
+    uint16_t channels(void) const {
+        return _header.channels;
+    };
+
+    T Ts(void) const {
+        return _header.Ts;
+    };
+
+    /**
+     * @return the index of the channel `name`, -1 if there is none.
+     */
+    int16_t channel(const char *name) const {
+        for (uint16_t k = 0; k < _header.channels; k++) {
+            if (strncmp(_names[k], name, TEST_VECTOR_NAME_SIZE) == 0) {
+                return k;
+            }
+        }
+        return -1;
+    };
+
+    /**
+     * @brief give the next frame.
+     *
+     * @return the `channels()` samples of the frame, valid until the next call,
+     * nullptr at the end of the vector or on a read error.
+     */
+    const T *next(void) {
+        if (_next >= _header.frames) {
+            return nullptr;
+        }
+        if (_frames != nullptr) {
+            return _frames + (_next++) * _header.channels;
+        }
+        if (_next >= _chunk_begin + _chunk_frames) {
+            _chunk_begin = _next;
+            _chunk_frames = fread(_chunk, sizeof(T) * _header.channels, CHUNK_FRAMES, _file);
+            if (_chunk_frames == 0) {
+                return nullptr;
+            }
+        }
+        return _chunk + (_next++ - _chunk_begin) * _header.channels;
+    };
+
+    /**
+     * @brief true when the frames are mapped or held in memory.
+     */
+    bool mapped(void) const {
+        return _frames != nullptr;
+    };
+
+private:
+    bool _valid(void) const {
+        return memcmp(_header.magic, "OTVF", 4) == 0 && _header.version == TEST_VECTOR_VERSION
+               && _header.sample_size == sizeof(T) && _header.channels != 0
+               && _header.channels <= MAX_CHANNELS;
+    };
+
+#ifdef OT_TEST_VECTOR_MMAP
+    int8_t _map(void) {
+        struct stat status;
+        int fd = fileno(_file);
+        if (fstat(fd, &status) != 0) {
+            close();
+            return -EIO;
+        }
+        uint64_t size = _data_offset + _header.frames * _header.channels * sizeof(T);
+        if ((uint64_t)status.st_size < size) {
+            close();
+            return -EIO;
+        }
+        _mapping_size = size;
+        _mapping = mmap(nullptr, _mapping_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (_mapping == MAP_FAILED) {
+            _mapping = nullptr;
+            close();
+            return -EIO;
+        }
+        madvise(_mapping, _mapping_size, MADV_SEQUENTIAL);
+        _frames = (const T *)((const uint8_t *)_mapping + _data_offset);
+        return 0;
+    };
+
+    void *_mapping = nullptr;
+    size_t _mapping_size = 0;
+#endif
+    FILE *_file = nullptr;
+    TestVectorHeader _header{};
+    char _names[MAX_CHANNELS][TEST_VECTOR_NAME_SIZE]{};
+    uint32_t _data_offset = 0;
+    uint64_t _next = 0;
+    const T *_frames = nullptr;
+    T _chunk[CHUNK_FRAMES * MAX_CHANNELS];
+    uint64_t _chunk_begin = 0;
+    uint32_t _chunk_frames = 0;
+};
+
+} // namespace sim
+} // namespace ot
+
+#endif
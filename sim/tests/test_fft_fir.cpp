@@ -0,0 +1,107 @@
+#include <zephyr/ztest.h>
+#include <zephyr/logging/log.h>
+#include <random>
+#include <vector>
+#include <fir.h>
+#include <fft_fir.h>
+
+LOG_MODULE_DECLARE(test_sim);
+
+ZTEST_SUITE(test_fft_fir, NULL, NULL, NULL, NULL, NULL);
+
+static std::vector<float64_t> randomSignal(size_t count, uint32_t seed) {
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<float64_t> distribution(-1.0, 1.0);
+    std::vector<float64_t> x(count);
+    for (auto &v : x) {
+        v = distribution(generator);
+    }
+    return x;
+}
+
+ZTEST(test_fft_fir, test_same_as_fir) {
+    ot_scalar_t coeffs[16];
+    for (int k = 0; k < 16; k++) {
+        coeffs[k] = 0.1F * (k + 1) * ((k & 1) ? -1.0F : 1.0F);
+    }
+    Fir fir;
+    zassert_equal(fir.init(16, coeffs), 0);
+    ot::sim::FftFir<ot_scalar_t> direct(coeffs, 16);
+    ot::sim::FftFir<ot_scalar_t> fft(coeffs, 16, ot::sim::FftFir<ot_scalar_t>::FFT);
+    zassert_false(direct.usesFft());
+    zassert_true(fft.usesFft());
+
+    std::vector<float64_t> x = randomSignal(500, 1);
+    for (size_t n = 0; n < x.size(); n++) {
+        ot_scalar_t input = x[n], y_direct, y_fft;
+        ot_scalar_t y = fir.update(input);
+        direct.process(&input, 1, &y_direct);
+        fft.process(&input, 1, &y_fft);
+        zassert_within(y_direct, y, 1e-5F, "n = %zu", n);
+        zassert_within(y_fft, y, 1e-5F, "n = %zu", n);
+    }
+}
+
+ZTEST(test_fft_fir, test_long_filter) {
+    const size_t nc = 1500;
+    std::vector<float64_t> coeffs = randomSignal(nc, 2);
+    std::vector<float64_t> x = randomSignal(20000, 3);
+    ot::sim::FftFir<float64_t> direct(coeffs.data(), nc, ot::sim::FftFir<float64_t>::DIRECT);
+    ot::sim::FftFir<float64_t> fft(coeffs.data(), nc);
+    zassert_true(fft.usesFft());
+    zassert_true(fft.blockSize() > nc);
+
+    std::vector<float64_t> y_direct(x.size()), y_fft(x.size());
+    direct.process(x.data(), x.size(), y_direct.data());
+    fft.process(x.data(), x.size(), y_fft.data());
+    for (size_t n = 0; n < x.size(); n++) {
+        zassert_within(y_fft[n], y_direct[n], 1e-9, "n = %zu", n);
+    }
+}
+
+ZTEST(test_fft_fir, test_chunks) {
+    const size_t nc = 300;
+    std::vector<float64_t> coeffs = randomSignal(nc, 4);
+    std::vector<float64_t> x = randomSignal(10000, 5);
+    ot::sim::FftFir<float64_t> whole(coeffs.data(), nc);
+    std::vector<float64_t> y_whole(x.size());
+    whole.process(x.data(), x.size(), y_whole.data());
+
+    // any size of chunks, in place, gives the same outputs
+    ot::sim::FftFir<float64_t> chunked(coeffs.data(), nc);
+    std::vector<float64_t> y = x;
+    std::mt19937 generator(6);
+    std::uniform_int_distribution<size_t> sizes(1, 2 * chunked.blockSize());
+    for (size_t n = 0; n < y.size();) {
+        size_t count = std::min(sizes(generator), y.size() - n);
+        chunked.process(&y[n], count, &y[n]);
+        n += count;
+    }
+    for (size_t n = 0; n < x.size(); n++) {
+        zassert_within(y[n], y_whole[n], 1e-9, "n = %zu", n);
+    }
+
+    // reset restarts from a zero history
+    chunked.reset();
+    chunked.process(x.data(), x.size(), y.data());
+    for (size_t n = 0; n < x.size(); n++) {
+        zassert_within(y[n], y_whole[n], 1e-9, "n = %zu", n);
+    }
+}
+
+ZTEST(test_fft_fir, test_sample_by_sample) {
+    // one sample by call is filtered directly, a whole block by an FFT
+    const size_t nc = 1500;
+    std::vector<float64_t> coeffs = randomSignal(nc, 7);
+    std::vector<float64_t> x = randomSignal(3 * 4096, 8);
+    ot::sim::FftFir<float64_t> whole(coeffs.data(), nc);
+    ot::sim::FftFir<float64_t> single(coeffs.data(), nc);
+    zassert_true(single.usesFft());
+    std::vector<float64_t> y_whole(x.size());
+    whole.process(x.data(), x.size(), y_whole.data());
+    for (size_t n = 0; n < x.size(); n++) {
+        float64_t y;
+        single.process(&x[n], 1, &y);
+        zassert_within(y, y_whole[n], 1e-9, "n = %zu", n);
+    }
+}
@@ -0,0 +1,83 @@
+#include <zephyr/ztest.h>
+#include <zephyr/logging/log.h>
+#include <pid.h>
+#include <filters.h>
+#include <simulation.h>
+
+LOG_MODULE_REGISTER(test_sim, LOG_LEVEL_INF);
+
+ZTEST_SUITE(test_plants, NULL, NULL, NULL, NULL, NULL);
+
+ZTEST(test_plants, test_rl_step) {
+    const float64_t Ts = 100e-6, R = 2.0, L = 10e-3;
+    ot::sim::RlLoad<float64_t> rl(Ts, R, L);
+    for (int k = 1; k <= 1000; k++) {
+        rl.step(1.0);
+        float64_t expected = (1.0 - exp(-R * k * Ts / L)) / R;
+        zassert_within(rl.output(), expected, 1e-12, "k = %d", k);
+    }
+}
+
+ZTEST(test_plants, test_lc_filter_steady_state) {
+    ot::sim::LcFilter<float64_t> lc(10e-6, 1e-3, 10e-6, 0.5);
+    lc.setLoadCurrent(2.0);
+    for (int k = 0; k < 20000; k++) {
+        lc.step(10.0);
+    }
+    // v = vin - R * i_load
+    zexpect_within(lc.output(), 9.0, 1e-3, "v = %f", lc.output());
+    zexpect_within(lc.current(), 2.0, 1e-3, "i = %f", lc.current());
+}
+
+ZTEST(test_plants, test_boost_steady_state) {
+    ot::sim::Boost<float64_t> boost(10e-6, 12.0, 1e-3, 100e-6, 20.0);
+    for (int k = 0; k < 50000; k++) {
+        boost.step(0.5);
+    }
+    zexpect_within(boost.output(), 24.0, 1e-2, "v = %f", boost.output());
+}
+
+ZTEST(test_plants, test_buck_pid) {
+    const ot_scalar_t Ts = 50e-6F;
+    ot::sim::Buck<ot_scalar_t> buck(Ts, 24.0F, 1e-3F, 100e-6F, 10.0F);
+    Pid pid(PidParams(Ts, 0.01F, 1e-3F, 0.0F, 0.0F, 0.0F, 1.0F));
+    ot_scalar_t last_u = 0.0F;
+    ot::sim::closedLoop(20000, pid, buck, [](uint32_t) { return 12.0F; },
+                        [&](uint32_t, ot_scalar_t, ot_scalar_t u) { last_u = u; });
+    zexpect_within(buck.output(), 12.0F, 1e-2F, "v = %f", buck.output());
+    zexpect_within(last_u, 0.5F, 1e-3F, "duty = %f", last_u);
+}
+
+ZTEST(test_plants, test_grid_pll) {
+    const ot_scalar_t Ts = 100e-6F;
+    const ot_scalar_t f0 = 50.0F;
+    ot::sim::ThreePhaseGrid<ot_scalar_t> grid(Ts, 1.0F, f0 * 1.02F);
+    PllAngle pll(Ts, f0, 0.02F);
+    PllDatas datas;
+    for (int k = 0; k < 5000; k++) {
+        grid.step();
+        datas = pll.calculateWithReturn(grid.angle());
+    }
+    zexpect_within(datas.w, 2.0F * PI * f0 * 1.02F, 0.1F, "w = %f", datas.w);
+    // the angle given by the pll is the one of the next step
+    zexpect_within(ot_sin(datas.angle - grid.angle() - datas.w * Ts), 0.0F, 1e-3F,
+                   "angle = %f, grid = %f", datas.angle, grid.angle());
+    three_phase_t v = grid.output();
+    zexpect_within(v.a + v.b + v.c, 0.0F, 1e-5F);
+}
+
+ZTEST(test_plants, test_pmsm_no_load_speed) {
+    const float64_t psi = 0.1, p = 4.0;
+    ot::sim::Pmsm<float64_t> pmsm(50e-6, 0.5, 1e-3, 1.5e-3, psi, p, 1e-4, 0.0);
+    for (int k = 0; k < 40000; k++) {
+        pmsm.step(ot::dqo_t<float64_t>(0.0, 10.0, 0.0));
+    }
+    // without load and friction the back emf equals vq: we * psi = vq
+    zexpect_within(pmsm.speed(), 10.0 / psi / p, 1e-3, "speed = %f", pmsm.speed());
+    zexpect_within(pmsm.output().q, 0.0, 1e-6);
+    pmsm.setLoadTorque(0.3);
+    for (int k = 0; k < 40000; k++) {
+        pmsm.step(ot::dqo_t<float64_t>(0.0, 10.0, 0.0));
+    }
+    zexpect_within(pmsm.electromagneticTorque(pmsm.output().d, pmsm.output().q), 0.3, 1e-4);
+}
@@ -0,0 +1,88 @@
+#include <zephyr/ztest.h>
+#include <zephyr/logging/log.h>
+#include <pid.h>
+#include <filters.h>
+#include <simulation.h>
+#include <replay.h>
+
+LOG_MODULE_DECLARE(test_sim);
+
+ZTEST_SUITE(test_replay, NULL, NULL, NULL, NULL, NULL);
+
+typedef ot::RecordSample<ot_scalar_t> Sample;
+
+static Sample record_buffer[1024];
+
+static const PidParams field_params(50e-6F, 0.02F, 1e-3F, 1e-5F, 10.0F, 0.0F, 1.0F);
+
+static ot_scalar_t field_reference(uint32_t k) {
+    return (k < 2000) ? 12.0F : 5.0F;
+}
+
+/*
+ * the field: `pid` regulates a Buck whose load changes, `record(k, y, u)` is
+ * called at each step and `recorder` is drained to `file`.
+ */
+template <typename F>
+static void record_field(FILE *file, Pid &pid, ot::Recorder<Sample> &recorder, F record) {
+    ot::sim::Buck<ot_scalar_t> buck(field_params.Ts, 24.0F, 1e-3F, 100e-6F, 10.0F);
+    auto drain = [&](const Sample *samples, uint32_t count) {
+        fwrite(samples, sizeof(Sample), count, file);
+    };
+    ot::sim::closedLoop(6000, pid, buck, field_reference,
+                        [&](uint32_t k, ot_scalar_t y, ot_scalar_t u) {
+        record(k, y, u);
+        if (k == 3000) {
+            buck.setLoad(2.0F);
+        }
+        if ((k & 511) == 511) {
+            recorder.drain(drain);
+        }
+    });
+    recorder.drain(drain);
+    zexpect_equal(recorder.getDropped(), 0);
+}
+
+/* the recording is replayed bit exact by a Pid with the same parameters only. */
+static void check_replay(FILE *file) {
+    rewind(file);
+    Pid pid(field_params);
+    ot::sim::ReplayResult result = ot::sim::replayController<ot_scalar_t>(file, pid);
+    zexpect_equal(result.samples, 6000);
+    zexpect_equal(result.mismatches, 0, "first mismatch at %llu",
+                  (unsigned long long)result.first_mismatch);
+
+    rewind(file);
+    Pid other(PidParams(50e-6F, 0.021F, 1e-3F, 1e-5F, 10.0F, 0.0F, 1.0F));
+    result = ot::sim::replayController<ot_scalar_t>(file, other);
+    zexpect_true(result.mismatches > 0);
+    zexpect_equal(result.first_mismatch, 0);
+}
+
+#ifdef CONTROL_LIB_RECORDER
+ZTEST(test_replay, test_pid_recorder) {
+    // the Pid records its own calculations
+    ot::Recorder<Sample> recorder;
+    recorder.init(record_buffer, 1024);
+    Pid pid(field_params);
+    pid.setRecorder(&recorder);
+    FILE *file = tmpfile();
+    record_field(file, pid, recorder, [](uint32_t, ot_scalar_t, ot_scalar_t) {});
+    check_replay(file);
+    fclose(file);
+}
+#else
+ZTEST(test_replay, test_pid_pushed) {
+    // without CONTROL_LIB_RECORDER, the loop pushes what the Pid would record
+    ot::Recorder<Sample> recorder;
+    recorder.init(record_buffer, 1024);
+    Pid pid(field_params);
+    FILE *file = tmpfile();
+    record_field(file, pid, recorder, [&](uint32_t k, ot_scalar_t y, ot_scalar_t u) {
+        recorder.push({field_reference(k), y, u,
+                       u <= field_params.lower_bound || u >= field_params.upper_bound});
+    });
+    check_replay(file);
+    fclose(file);
+}
+#endif
@@ -0,0 +1,127 @@
+#include <zephyr/ztest.h>
+#include <zephyr/logging/log.h>
+#include <pid.h>
+#include <simulation.h>
+#include <sweep.h>
+
+LOG_MODULE_DECLARE(test_sim);
+
+ZTEST_SUITE(test_sweep, NULL, NULL, NULL, NULL, NULL);
+
+ZTEST(test_sweep, test_parallel_for) {
+    const uint32_t count = 1000;
+    std::vector<std::atomic<uint32_t>> visits(count);
+    ot::sim::parallelFor(count, [&](uint32_t k) { visits[k]++; }, 4);
+    for (uint32_t k = 0; k < count; k++) {
+        zassert_equal(visits[k].load(), 1, "index %u visited %u times", k, visits[k].load());
+    }
+}
+
+ZTEST(test_sweep, test_step_metrics) {
+    const float64_t Ts = 1e-4, tau = 1e-2;
+    ot::sim::StepMetrics<float64_t> metrics(Ts, 1.0, 0.0, 1.0);
+    for (int k = 0; k < 2000; k++) {
+        float64_t y = 1.0 - exp(-k * Ts / tau);
+        metrics.add(y, (k < 100) ? 1.0 : 0.5);
+    }
+    ot::sim::RunMetrics m = metrics.result();
+    zexpect_within(m.overshoot, 0.0, 1e-9);
+    // 2% band: t = tau * ln(50)
+    zexpect_within(m.settling_time, tau * log(50.0), 2 * Ts, "settling = %f", m.settling_time);
+    zexpect_within(m.ise, tau / 2, 1e-4, "ise = %f", m.ise);
+    zexpect_within(m.saturation_time, 100 * Ts, 1e-9);
+}
+
+ZTEST(test_sweep, test_overshoot) {
+    // relative to the step: from 1 to 2 with a peak at 2.1, then a null step
+    ot::sim::StepMetrics<float64_t> metrics(1e-4, 2.0, 0.0, 1.0, 0.02, 1.0);
+    for (float64_t y : {1.0, 1.5, 2.1, 2.0}) {
+        metrics.add(y, 0.5);
+    }
+    zexpect_within(metrics.result().overshoot, 0.1, 1e-6, "overshoot = %f", metrics.result().overshoot);
+    ot::sim::StepMetrics<float64_t> down(1e-4, -1.0, -1.0, 1.0);
+    for (float64_t y : {-0.5, -1.2, -1.0}) {
+        down.add(y, 0.0);
+    }
+    zexpect_within(down.result().overshoot, 0.2, 1e-6);
+    ot::sim::StepMetrics<float64_t> null(1e-4, 0.0, -1.0, 1.0);
+    null.add(0.1, 0.0);
+    zexpect_equal(null.result().overshoot, 0.0F);
+}
+
+static ot::sim::RunMetrics buck_step(const PidParams &p) {
+    ot::sim::Buck<float32_t> buck(p.Ts, 24.0F, 1e-3F, 100e-6F, 10.0F);
+    Pid pid(p);
+    ot::sim::StepMetrics<float32_t> metrics(p.Ts, 12.0F, p.lower_bound, p.upper_bound);
+    ot::sim::closedLoop(4000, pid, buck, [](uint32_t) { return 12.0F; }, metrics);
+    return metrics.result();
+}
+
+ZTEST(test_sweep, test_pid_sweep) {
+    std::vector<PidParams> params;
+    for (int k = 1; k <= 16; k++) {
+        params.push_back(PidParams(50e-6F, 0.002F * k, 1e-3F, 0.0F, 0.0F, 0.0F, 1.0F));
+    }
+    std::vector<ot::sim::RunMetrics> serial = ot::sim::sweep(params, buck_step, 1);
+    std::vector<ot::sim::RunMetrics> parallel = ot::sim::sweep(params, buck_step, 4);
+    zassert_equal(parallel.size(), params.size());
+    for (size_t k = 0; k < params.size(); k++) {
+        zexpect_equal(memcmp(&serial[k], &parallel[k], sizeof(ot::sim::RunMetrics)), 0, "run %zu", k);
+        zexpect_true(serial[k].settling_time > 0.0F, "run %zu does not settle: %f", k, serial[k].settling_time);
+    }
+
+    FILE *file = tmpfile();
+    ot::sim::writeBinary(file, parallel);
+    rewind(file);
+    char magic[4];
+    uint32_t count;
+    ot::sim::RunMetrics first;
+    zassert_equal(fread(magic, 1, 4, file), 4);
+    zexpect_equal(memcmp(magic, "OTSW", 4), 0);
+    zassert_equal(fread(&count, sizeof(count), 1, file), 1);
+    zexpect_equal(count, params.size());
+    zassert_equal(fread(&first, sizeof(first), 1, file), 1);
+    zexpect_equal(first.ise, parallel[0].ise);
+    fclose(file);
+}
+
+ZTEST(test_sweep, test_stream) {
+    std::vector<PidParams> params;
+    for (int k = 1; k <= 16; k++) {
+        params.push_back(PidParams(50e-6F, 0.002F * k, 1e-3F, 0.0F, 0.0F, 0.0F, 1.0F));
+    }
+    std::vector<ot::sim::RunMetrics> serial = ot::sim::sweep(params, buck_step, 1);
+
+    // each run is in its slot of the binary file, whatever the order they end in
+    FILE *file = tmpfile();
+    ot::sim::SweepWriter binary(file, ot::sim::SweepWriter::BINARY, params.size());
+    ot::sim::sweepStream(params, buck_step, binary, 4);
+    fseek(file, 0, SEEK_END);
+    zassert_equal(ftell(file), 8 + 16 * sizeof(ot::sim::RunMetrics));
+    fseek(file, 8, SEEK_SET);
+    for (size_t k = 0; k < params.size(); k++) {
+        ot::sim::RunMetrics m;
+        zassert_equal(fread(&m, sizeof(m), 1, file), 1);
+        zexpect_equal(memcmp(&m, &serial[k], sizeof(m)), 0, "run %zu", k);
+    }
+    fclose(file);
+
+    file = tmpfile();
+    ot::sim::SweepWriter csv(file, ot::sim::SweepWriter::CSV, params.size());
+    std::vector<bool> seen(params.size());
+    ot::sim::sweepStream(params, buck_step, [&](uint32_t k, const ot::sim::RunMetrics &m) {
+        seen[k] = true;
+        csv(k, m);
+    }, 4);
+    rewind(file);
+    char line[128];
+    uint32_t lines = 0;
+    while (fgets(line, sizeof(line), file) != nullptr) {
+        lines++;
+    }
+    zexpect_equal(lines, params.size() + 1);
+    for (size_t k = 0; k < params.size(); k++) {
+        zexpect_true(seen[k], "run %zu", k);
+    }
+    fclose(file);
+}
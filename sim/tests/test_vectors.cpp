@@ -0,0 +1,65 @@
+#include <initializer_list>
+#include <vector>
+#include <zephyr/ztest.h>
+#include <zephyr/logging/log.h>
+#include <test_vector.h>
+
+LOG_MODULE_DECLARE(test_sim);
+
+ZTEST_SUITE(test_vectors, NULL, NULL, NULL, NULL, NULL);
+
+static const char *const names[] = {"reference", "measure", "output"};
+
+ZTEST(test_vectors, test_round_trip) {
+    const char *path = "test_vector_round_trip.otv";
+    ot::sim::TestVectorWriter<float32_t> writer;
+    zassert_equal(writer.open(path, 1e-4F, 3, names), 0);
+    for (uint32_t k = 0; k < 1000; k++) {
+        float32_t frame[3] = {(float32_t)k, -(float32_t)k, 0.5F * k};
+        writer.write(frame);
+    }
+    zassert_equal(writer.close(), 0);
+
+    for (bool chunked : {false, true}) {
+        ot::sim::TestVectorReader<float32_t> reader;
+        zassert_equal(reader.open(path, chunked), 0);
+        zexpect_equal(reader.frames(), 1000);
+        zexpect_equal(reader.channels(), 3);
+        zexpect_equal(reader.Ts(), 1e-4F);
+        zexpect_equal(reader.channel("output"), 2);
+        zexpect_equal(reader.channel("none"), -1);
+        uint32_t count = 0;
+        const float32_t *frame;
+        while ((frame = reader.next()) != nullptr) {
+            zassert_equal(frame[0], (float32_t)count, "chunked %d, frame %u", chunked, count);
+            zassert_equal(frame[2], 0.5F * count);
+            count++;
+        }
+        zexpect_equal(count, 1000);
+    }
+    ot::sim::TestVectorReader<float64_t> wrong_type;
+    zexpect_equal(wrong_type.open(path), -EINVAL);
+    zexpect_equal(wrong_type.open("no_such_vector.otv"), -ENOENT);
+
+    // the same vector embedded in memory is read in place
+    FILE *file = fopen(path, "rb");
+    zassert_not_null(file);
+    std::vector<uint64_t> content(4096);
+    size_t size = fread(content.data(), 1, content.size() * sizeof(uint64_t), file);
+    fclose(file);
+    const uint8_t *data = reinterpret_cast<const uint8_t *>(content.data());
+    ot::sim::TestVectorReader<float32_t> embedded;
+    zassert_equal(embedded.open(data, size), 0);
+    zexpect_true(embedded.mapped());
+    zexpect_equal(embedded.channel("measure"), 1);
+    uint32_t count = 0;
+    const float32_t *frame;
+    while ((frame = embedded.next()) != nullptr) {
+        zassert_equal(frame[1], -(float32_t)count, "frame %u", count);
+        count++;
+    }
+    zexpect_equal(count, 1000);
+    zexpect_equal(embedded.open(data, size - 1), -EIO);
+    zexpect_equal(wrong_type.open(data, size), -EINVAL);
+    remove(path);
+}
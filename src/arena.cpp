@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date 2024
+ * @author Régis Ruelland <regis.ruelland@laas.fr>
+ */
+#include <errno.h>
+#include <stddef.h>
+#include <string.h>
+#include <zephyr/logging/log.h>
+#include "arena.h"
+#include "no_heap.h"
+
+LOG_MODULE_DECLARE(ot_control);
+
+namespace ot {
+
+int8_t Arena::init(void *region, size_t size) {
+    if (region == nullptr) {
+        LOG_ERR("region = nullptr");
+        return -EINVAL;
+    }
+    if (_used != 0 || _free_list != nullptr) {
+        LOG_ERR("arena already in use");
+        return -EBUSY;
+    }
+    _region = static_cast<uint8_t *>(region);
+    _size = size;
+    return 0;
+}
+
+void *Arena::allocate(size_t size, size_t align) {
+    size = _round(size);
+    // first fit in the blocks given back, the tail of a bigger one stays free
+    FreeBlock header;
+    uint8_t *previous = nullptr;
+    for (uint8_t *block = _free_list; block != nullptr; block = header.next) {
+        memcpy(&header, block, sizeof(header));
+        if (header.size >= size && reinterpret_cast<uintptr_t>(block) % align == 0) {
+            _unlink(previous, header.next);
+            _free -= header.size;
+            if (header.size > size) {
+                _push(block + size, header.size - size);
+            }
+            _allocations++;
+            return block;
+        }
+        previous = block;
+    }
+    uintptr_t start = reinterpret_cast<uintptr_t>(_region) + _used;
+    uintptr_t aligned = (start + align - 1) & ~(uintptr_t)(align - 1);
+    size_t new_used = _used + (aligned - start) + size;
+    if (new_used > _size) {
+        LOG_ERR("arena full: %zu bytes requested, %zu free", size, _size - _used);
+        _failures++;
+        return nullptr;
+    }
+    _used = new_used;
+    _allocations++;
+    return reinterpret_cast<void *>(aligned);
+}
+
+void Arena::deallocate(void *ptr, size_t size) {
+    if (ptr == nullptr || !owns(ptr)) {
+        return;
+    }
+    uint8_t *block = static_cast<uint8_t *>(ptr);
+    size = _round(size);
+    // merge with the free blocks just before and just after
+    FreeBlock header;
+    bool merged = true;
+    while (merged) {
+        merged = false;
+        uint8_t *previous = nullptr;
+        for (uint8_t *other = _free_list; other != nullptr; other = header.next) {
+            memcpy(&header, other, sizeof(header));
+            if (other + header.size == block || block + size == other) {
+                _unlink(previous, header.next);
+                _free -= header.size;
+                block = (other < block) ? other : block;
+                size += header.size;
+                merged = true;
+                break;
+            }
+            previous = other;
+        }
+    }
+    if (block + size == _region + _used) {
+        _used = block - _region;
+        return;
+    }
+    _push(block, size);
+}
+
+void Arena::_push(uint8_t *block, size_t size) {
+    FreeBlock header = {size, _free_list};
+    memcpy(block, &header, sizeof(header));
+    _free_list = block;
+    _free += size;
+}
+
+void Arena::_unlink(uint8_t *previous, uint8_t *next) {
+    if (previous == nullptr) {
+        _free_list = next;
+    } else {
+        memcpy(previous + offsetof(FreeBlock, next), &next, sizeof(next));
+    }
+}
+
+bool Arena::owns(const void *ptr) const {
+    const uint8_t *p = static_cast<const uint8_t *>(ptr);
+    return p >= _region && p < _region + _size;
+}
+
+ArenaStats Arena::getStats() const {
+    return ArenaStats(_size, _used, _free, _allocations, _failures);
+}
+
+} // namespace ot
+
+alignas(8) static uint8_t arena_buffer[CONTROL_LIB_ARENA_SIZE];
+Arena controlLibArena = Arena(arena_buffer, sizeof(arena_buffer));
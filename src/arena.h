@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date 2024
+ * @author Régis Ruelland <regis.ruelland@laas.fr>
+ */
+#ifndef ARENA_H_
+#define ARENA_H_
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * size in bytes of the static buffer used by default by `controlLibArena`.
+ */
+#ifndef CONTROL_LIB_ARENA_SIZE
+#define CONTROL_LIB_ARENA_SIZE 1024
+#endif
+
+namespace ot {
+
+/**
+ * @class ArenaStats
+ * @brief memory use of an Arena
+ *
+ * @param capacity size of the memory region [bytes]
+ *
+ * @param used bytes carved from the region (alignment padding and rounding
+ * included)
+ *
+ * @param free bytes given back and waiting to be reused
+ *
+ * @param allocations number of successful allocations
+ *
+ * @param failures number of allocations which did not fit in the region. Without
+ * `CONTROL_LIB_NO_HEAP` they have been taken from the heap instead.
+ */
+struct ArenaStats {
+    size_t capacity;
+    size_t used;
+    size_t free;
+    uint32_t allocations;
+    uint32_t failures;
+};
+
+/**
+ * @class Arena
+ * @brief bump allocator carving the storage of the filters in a fixed memory region.
+ *
+ * Blocks given back with `deallocate` (a `Fir` destroyed or initialized with
+ * more coefficients) are reused: they are merged with their free neighbours,
+ * the last carved blocks return to the region and the others are kept in a
+ * free list. The next allocation takes the first free block big enough and
+ * leaves its tail in the list. Sizes are rounded up to `GRANULE`, the header
+ * of the list, so that every byte given back can be reused. It is designed to
+ * be used during initialisation, not in the control loop, and it is not thread
+ * safe.
+ *
+ * By default, all the `Fir` storage comes from `controlLibArena`, backed by a
+ * static buffer of `CONTROL_LIB_ARENA_SIZE` bytes. It can be moved to a user
+ * supplied region with `init` before the first controller is initialized.
+ *
+ * If an allocation does not fit, `Fir` falls back to the heap, unless
+ * `CONTROL_LIB_NO_HEAP` is defined: then any heap allocation in the library is
+ * a build error and `Fir::init` returns -ENOMEM.
+ */
+class Arena {
+public:
+    /**
+     * sizes are rounded up to a multiple of GRANULE bytes, the size of the
+     * header of a free block.
+     */
+    static constexpr size_t GRANULE = sizeof(size_t) + sizeof(uint8_t *);
+
+    constexpr Arena(void *region, size_t size)
+        : _region(static_cast<uint8_t *>(region)), _size(size),
+          _used(0), _free(0), _allocations(0), _failures(0) {};
+
+    /**
+     * @brief use a user supplied memory region.
+     *
+     * @param region pointer to the memory region
+     * @param size size of the region in bytes
+     * @return 0 if ok, -EINVAL if region is null, -EBUSY if memory has already
+     * been allocated.
+     */
+    int8_t init(void *region, size_t size);
+
+    /**
+     * @brief carve `size` bytes aligned on `align` from the region.
+     *
+     * @return pointer to the memory or nullptr if it does not fit.
+     */
+    void *allocate(size_t size, size_t align);
+
+    /**
+     * @brief give back a block returned by `allocate(size, align)`.
+     */
+    void deallocate(void *ptr, size_t size);
+
+    /**
+     * @brief true if `ptr` points inside the region.
+     */
+    bool owns(const void *ptr) const;
+
+    ArenaStats getStats() const;
+
+private:
+    /**
+     * @brief header copied at the beginning of a free block, which may not be
+     * aligned for it.
+     */
+    struct FreeBlock {
+        size_t size;
+        uint8_t *next;
+    };
+    static_assert(sizeof(FreeBlock) == GRANULE, "a free block holds its header");
+
+    static constexpr size_t _round(size_t size) {
+        return (size + GRANULE - 1) / GRANULE * GRANULE;
+    };
+
+    void _push(uint8_t *block, size_t size);
+    void _unlink(uint8_t *previous, uint8_t *next);
+
+    uint8_t *_region;
+    size_t _size;
+    size_t _used;
+    size_t _free;
+    uint8_t *_free_list = nullptr;
+    uint32_t _allocations;
+    uint32_t _failures;
+};
+
+} // namespace ot
+
+typedef ot::ArenaStats ArenaStats;
+typedef ot::Arena Arena;
+
+extern Arena controlLibArena;
+#endif
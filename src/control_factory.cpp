@@ -1,47 +1,103 @@
 #include "control_factory.h"
+#include "no_heap.h"
 
-Pid ControlFactory::pid(float32_t Ts, float32_t Kp, float32_t Ti, float32_t Td, float32_t N, float32_t lower_bound, float32_t upper_bound) {
-    PidParams p(Ts, Kp, Ti, Td, N, lower_bound, upper_bound);
-    Pid controller = Pid();
+namespace ot {
+
+template <typename T>
+Pid<T> ControlFactory<T>::pid(T Ts, T Kp, T Ti, T Td, T N, T lower_bound, T upper_bound) {
+    PidParams<T> p(Ts, Kp, Ti, Td, N, lower_bound, upper_bound);
+    Pid<T> controller = Pid<T>();
     controller.init(p);
     return controller;
 }
 
-Pr ControlFactory::pr(float32_t Ts, float32_t Kp, float32_t Kr, float32_t w0, float32_t phi_prime, float32_t lower_bound, float32_t upper_bound){
-    PrParams p(Ts, Kp, Kr, w0, phi_prime, lower_bound, upper_bound);
-    Pr controller = Pr();
+template <typename T>
+int8_t ControlFactory<T>::pid(Pid<T> &controller, T Ts, T Kp, T Ti, T Td, T N, T lower_bound, T upper_bound) {
+    PidParams<T> p(Ts, Kp, Ti, Td, N, lower_bound, upper_bound);
+    return controller.init(p);
+}
+
+template <typename T>
+Pr<T> ControlFactory<T>::pr(T Ts, T Kp, T Kr, T w0, T phi_prime, T lower_bound, T upper_bound){
+    PrParams<T> p(Ts, Kp, Kr, w0, phi_prime, lower_bound, upper_bound);
+    Pr<T> controller = Pr<T>();
     controller.init(p);
     return controller;
 }
 
-RST ControlFactory::rst(float32_t Ts, uint8_t nr, const float32_t *r, uint8_t ns, const float32_t *s, uint8_t nt, const float32_t *t, float32_t lower_bound, float32_t upper_bound){
-    RstParams p(Ts, nr, r, ns, s, nt, t, lower_bound, upper_bound);
-    RST controller = RST();
+template <typename T>
+int8_t ControlFactory<T>::pr(Pr<T> &controller, T Ts, T Kp, T Kr, T w0, T phi_prime, T lower_bound, T upper_bound){
+    PrParams<T> p(Ts, Kp, Kr, w0, phi_prime, lower_bound, upper_bound);
+    return controller.init(p);
+}
+
+template <typename T>
+RST<T> ControlFactory<T>::rst(T Ts, uint8_t nr, const T *r, uint8_t ns, const T *s, uint8_t nt, const T *t, T lower_bound, T upper_bound){
+    RstParams<T> p(Ts, nr, r, ns, s, nt, t, lower_bound, upper_bound);
+    RST<T> controller = RST<T>();
     controller.init(p);
     return controller;
 }
 
-PllSinus ControlFactory::pllSinus(float32_t Ts, float32_t amplitude, float32_t f0, float32_t rise_time){
-    PllSinus pll = PllSinus(Ts, amplitude, f0, rise_time);
+template <typename T>
+int8_t ControlFactory<T>::rst(RST<T> &controller, T Ts, uint8_t nr, const T *r, uint8_t ns, const T *s, uint8_t nt, const T *t, T lower_bound, T upper_bound){
+    RstParams<T> p(Ts, nr, r, ns, s, nt, t, lower_bound, upper_bound);
+    return controller.init(p);
+}
+
+template <typename T>
+PllSinus<T> ControlFactory<T>::pllSinus(T Ts, T amplitude, T f0, T rise_time){
+    PllSinus<T> pll = PllSinus<T>(Ts, amplitude, f0, rise_time);
     return pll;
 }
 
-PllAngle ControlFactory::pllAngle(float32_t Ts, float32_t f0, float32_t rise_time) {
-    PllAngle pll = PllAngle(Ts, f0, rise_time);
+template <typename T>
+int8_t ControlFactory<T>::pllSinus(PllSinus<T> &pll, T Ts, T amplitude, T f0, T rise_time){
+    return pll.init(Ts, amplitude, f0, rise_time);
+}
+
+template <typename T>
+PllAngle<T> ControlFactory<T>::pllAngle(T Ts, T f0, T rise_time) {
+    PllAngle<T> pll = PllAngle<T>(Ts, f0, rise_time);
     return pll;
 }
 
-NotchFilter ControlFactory::notchfilter(float32_t Ts, float32_t f0, float32_t bandwidth){
-    NotchFilter filter = NotchFilter(Ts, f0, bandwidth);
+template <typename T>
+int8_t ControlFactory<T>::pllAngle(PllAngle<T> &pll, T Ts, T f0, T rise_time) {
+    return pll.init(Ts, f0, rise_time);
+}
+
+template <typename T>
+NotchFilter<T> ControlFactory<T>::notchfilter(T Ts, T f0, T bandwidth){
+    NotchFilter<T> filter = NotchFilter<T>(Ts, f0, bandwidth);
     filter.reset();
     return filter;
 }
 
-LowPassFirstOrderFilter  ControlFactory::lowpassfilter(float32_t Ts, float32_t tau){
-    LowPassFirstOrderFilter filter = LowPassFirstOrderFilter(Ts, tau);
+template <typename T>
+int8_t ControlFactory<T>::notchfilter(NotchFilter<T> &filter, T Ts, T f0, T bandwidth){
+    int8_t ret = filter.init(Ts, f0, bandwidth);
+    filter.reset();
+    return ret;
+}
+
+template <typename T>
+LowPassFirstOrderFilter<T>  ControlFactory<T>::lowpassfilter(T Ts, T tau){
+    LowPassFirstOrderFilter<T> filter = LowPassFirstOrderFilter<T>(Ts, tau);
     filter.reset();
     return filter;
 }
 
-ControlFactory controlLibFactory = ControlFactory();
+template <typename T>
+int8_t ControlFactory<T>::lowpassfilter(LowPassFirstOrderFilter<T> &filter, T Ts, T tau){
+    int8_t ret = filter.init(Ts, tau);
+    filter.reset();
+    return ret;
+}
+
+template class ControlFactory<float32_t>;
+template class ControlFactory<float64_t>;
 
+} // namespace ot
+
+ControlFactory controlLibFactory = ControlFactory();
@@ -1,9 +1,22 @@
+#ifndef CONTROL_FACTORY_H_
+#define CONTROL_FACTORY_H_
 #include "pid.h"
 #include "pr.h"
 #include "rst.h"
 #include "filters.h"
 
+namespace ot {
 
+/**
+ * @brief helper to build initialized controllers and filters.
+ *
+ * Each method has two forms: one returning the object by value (it is moved
+ * out), and one initializing in place an object already in its final storage
+ * (e.g. a static variable) which returns the `init` status.
+ *
+ * @tparam T scalar type
+ */
+template <typename T = ot_scalar_t>
 class ControlFactory {
     public:
     ControlFactory() {};
@@ -19,7 +32,13 @@ class ControlFactory {
      * @param upper_bound 
      * @return Pid 
      */
-    Pid pid(float32_t Ts, float32_t Kp, float32_t Ti, float32_t Td, float32_t N, float32_t lower_bound, float32_t upper_bound);
+    Pid<T> pid(T Ts, T Kp, T Ti, T Td, T N, T lower_bound, T upper_bound);
+    /**
+     * @brief initialize in place `controller` as a Pid in a standard form.
+     *
+     * @return 0 if ok, -EINVAL else.
+     */
+    int8_t pid(Pid<T> &controller, T Ts, T Kp, T Ti, T Td, T N, T lower_bound, T upper_bound);
     /**
      * @brief return a Proportional Resonant controller for a fixed pulsation `w0`[rad/s] and possible advanced phase `phi_prime`[rad]
      * 
@@ -32,7 +51,13 @@ class ControlFactory {
      * @param upper_bound 
      * @return * Pr 
      */
-    Pr pr(float32_t Ts, float32_t Kp, float32_t Kr, float32_t w0, float32_t phi_prime, float32_t lower_bound, float32_t upper_bound);
+    Pr<T> pr(T Ts, T Kp, T Kr, T w0, T phi_prime, T lower_bound, T upper_bound);
+    /**
+     * @brief initialize in place `controller` as a Proportional Resonant controller.
+     *
+     * @return 0 if ok, -EINVAL or -ENOMEM else.
+     */
+    int8_t pr(Pr<T> &controller, T Ts, T Kp, T Kr, T w0, T phi_prime, T lower_bound, T upper_bound);
     /**
      * @brief return a polynomial RST controller
      * 
@@ -47,7 +72,13 @@ class ControlFactory {
      * @param upper_bound 
      * @return RST 
      */
-    RST rst(float32_t Ts, uint8_t nr, const float32_t *r, uint8_t ns, const float32_t *s, uint8_t nt, const float32_t *t, float32_t lower_bound, float32_t upper_bound);
+    RST<T> rst(T Ts, uint8_t nr, const T *r, uint8_t ns, const T *s, uint8_t nt, const T *t, T lower_bound, T upper_bound);
+    /**
+     * @brief initialize in place `controller` as a polynomial RST controller.
+     *
+     * @return 0 if ok, -EINVAL or -ENOMEM else.
+     */
+    int8_t rst(RST<T> &controller, T Ts, uint8_t nr, const T *r, uint8_t ns, const T *s, uint8_t nt, const T *t, T lower_bound, T upper_bound);
     /**
      * @brief return a phase locked loop filter adapated to sinus tracking at a fixed `f0`[Hz] frequency with a fixed `amplitude` and with a `rise_time` [s] dynamic
      * 
@@ -57,7 +88,13 @@ class ControlFactory {
      * @param rise_time [s]
      * @return PllSinus 
      */
-    PllSinus pllSinus(float32_t Ts, float32_t amplitude, float32_t f0, float32_t rise_time);
+    PllSinus<T> pllSinus(T Ts, T amplitude, T f0, T rise_time);
+    /**
+     * @brief initialize in place `pll` as a phase locked loop on a sinus.
+     *
+     * @return 0 if ok, -EINVAL else.
+     */
+    int8_t pllSinus(PllSinus<T> &pll, T Ts, T amplitude, T f0, T rise_time);
     /**
      * @brief return a phase locked loop filter adapated to a saw-tooth between [0, 2Π], tracking at a fixed `f0`[Hz] frequency with a `rise_time` [s] dynamic
      * 
@@ -66,7 +103,13 @@ class ControlFactory {
      * @param rise_time [s]
      * @return PllAngle
      */
-    PllAngle pllAngle(float32_t Ts, float32_t f0, float32_t rise_time);
+    PllAngle<T> pllAngle(T Ts, T f0, T rise_time);
+    /**
+     * @brief initialize in place `pll` as a phase locked loop on a saw-tooth.
+     *
+     * @return 0 if ok, -EINVAL else.
+     */
+    int8_t pllAngle(PllAngle<T> &pll, T Ts, T f0, T rise_time);
 
     /**
      * @brief return a notch filter around the frequency `f0`[Hz] with a `bandwidth` [Hz]
@@ -76,7 +119,13 @@ class ControlFactory {
      * @param bandwidth bandwidth around f0 where gain < -3dB [Hz]
      * @return NotchFilter 
      */
-    NotchFilter notchfilter(float32_t Ts, float32_t f0, float32_t bandwidth);
+    NotchFilter<T> notchfilter(T Ts, T f0, T bandwidth);
+    /**
+     * @brief initialize in place `filter` as a notch filter.
+     *
+     * @return 0 if ok, -EINVAL else.
+     */
+    int8_t notchfilter(NotchFilter<T> &filter, T Ts, T f0, T bandwidth);
     /**
      * @brief low pass filter
      * 
@@ -84,7 +133,18 @@ class ControlFactory {
      * @param tau constant time [s]
      * @return LowPassFirstOrderFilter 
      */
-    LowPassFirstOrderFilter lowpassfilter(float32_t Ts, float32_t tau);
+    LowPassFirstOrderFilter<T> lowpassfilter(T Ts, T tau);
+    /**
+     * @brief initialize in place `filter` as a low pass filter.
+     *
+     * @return 0 if ok, -EINVAL else.
+     */
+    int8_t lowpassfilter(LowPassFirstOrderFilter<T> &filter, T Ts, T tau);
 };
 
+} // namespace ot
+
+typedef ot::ControlFactory<> ControlFactory;
+
 extern ControlFactory controlLibFactory;
+#endif
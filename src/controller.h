@@ -28,7 +28,22 @@
 #include <arm_math.h>
 #ifndef CONTROLLER_H_
 #define CONTROLLER_H_
+#include <concepts>
 #include <zephyr/logging/log.h>
+#include "scalar.h"
+#ifdef CONTROL_LIB_MAILBOX
+#include "mailbox.h"
+#endif
+#include "cycles.h"
+#include "recorder.h"
+
+/**
+ * @brief called by the constexpr constructors when parameters are invalid.
+ *
+ * It is not constexpr on purpose: a `constexpr` or `constinit` object built with
+ * invalid parameters does not compile. At run time it logs `message`.
+ */
+void ot_invalid_parameters(const char *message);
 
 /**
  * @brief Controller interface for various inherited class like pid, rst, pr,...
@@ -37,12 +52,14 @@
  * @tparam meas_T type of the measure
  * @tparam outputs_T type of the output
  * @tparam params_T type of the parameter 
+ * @tparam scalar_T scalar type used for the sample time.
  * @param parameters structure including all parameters needs to make calculations. 
  *
- * we assume that outputs_T has already an order relation implemented.
+ * the default saturation uses the order relation of outputs_T; a controller with
+ * an output without one (a vector) overrides `saturate` and `setBounds`.
  *
  */
-template<typename refs_T, typename meas_T, typename outputs_T, typename params_T>
+template<typename refs_T, typename meas_T, typename outputs_T, typename params_T, typename scalar_T = ot_scalar_t>
 class Controller
 {
     public:
@@ -98,6 +115,37 @@ class Controller
         _measure = measure;
     }; 
 
+#ifdef CONTROL_LIB_MAILBOX
+    /**
+     * @brief post a new reference from another context than `calculate`, e.g.
+     * a supervisory thread. It never waits.
+     *
+     * @param reference taken by the next call to `receive`.
+     */
+    void postReference(refs_T reference) {
+        _reference_mailbox.post(reference);
+    };
+
+    /**
+     * @brief post a new measurement from another context than `calculate`.
+     *
+     * @param measure taken by the next call to `receive`.
+     */
+    void postMeasurement(meas_T measure) {
+        _measure_mailbox.post(measure);
+    };
+
+    /**
+     * @brief capture the last reference and measurement posted, if any, to be
+     * used by `calculate`. It is called in the context of `calculate` and
+     * never waits, a value being never read partially written.
+     */
+    void receive(void) {
+        _reference_mailbox.take(_reference);
+        _measure_mailbox.take(_measure);
+    };
+#endif
+
     /**
      * @brief retrieve the last command value calculated.
      *
@@ -115,11 +163,13 @@ class Controller
      * @return 
      */
     virtual outputs_T saturate(outputs_T u) {
-        if ( u > _upper_bound) {
-            u = _upper_bound;
-        }
-        if (u < _lower_bound) {
-            u = _lower_bound;
+        if constexpr (std::totally_ordered<outputs_T>) {
+            if ( u > _upper_bound) {
+                u = _upper_bound;
+            }
+            if (u < _lower_bound) {
+                u = _lower_bound;
+            }
         }
         return u;
     };
@@ -131,22 +181,59 @@ class Controller
      * @param upper
      * @return 
      */
-    virtual void setBounds(float32_t lower, float32_t upper) {
-        if (lower < upper) {
-            _lower_bound = lower;
-            _upper_bound = upper;
+    virtual void setBounds(outputs_T lower, outputs_T upper) {
+        if constexpr (std::totally_ordered<outputs_T>) {
+            if (lower < upper) {
+                _lower_bound = lower;
+                _upper_bound = upper;
+            }
         }
     }
 
+#ifdef CONTROL_LIB_CYCLES
+    /**
+     * @brief durations of the `calculate` calls.
+     */
+    const ot::CycleStats &getCycleStats(void) const {
+        return _cycles;
+    };
+
+    void resetCycleStats(void) {
+        _cycles.reset();
+    };
+#endif
+
+#ifdef CONTROL_LIB_RECORDER
+    typedef ot::RecordSample<refs_T, meas_T, outputs_T> Sample;
+
+    /**
+     * @brief record each calculation in `recorder`, nullptr to stop.
+     */
+    void setRecorder(ot::Recorder<Sample> *recorder) {
+        _recorder = recorder;
+    };
+#endif
+
 protected:
-    float32_t _Ts; // sample time
-    outputs_T _lower_bound;
-    outputs_T _upper_bound;
+    // initialized to allow constexpr constructors in inherited classes
+    scalar_T _Ts{}; // sample time
+    outputs_T _lower_bound{};
+    outputs_T _upper_bound{};
     // template 
-    refs_T _reference;
-    outputs_T _output;
-    meas_T _measure;
+    refs_T _reference{};
+    outputs_T _output{};
+    meas_T _measure{};
 
+#ifdef CONTROL_LIB_MAILBOX
+    ot::Mailbox<refs_T> _reference_mailbox;
+    ot::Mailbox<meas_T> _measure_mailbox;
+#endif
+#ifdef CONTROL_LIB_CYCLES
+    ot::CycleStats _cycles;
+#endif
+#ifdef CONTROL_LIB_RECORDER
+    ot::Recorder<Sample> *_recorder = nullptr;
+#endif
 };
 
 #endif /* !CONTROLLER_H_ */
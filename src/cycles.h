@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date 2024
+ * @author Régis Ruelland <regis.ruelland@laas.fr>
+ *
+ * Execution time of the `calculate` methods.
+ *
+ * When `CONTROL_LIB_CYCLES` is defined, each controller and pll records the
+ * duration of its calculation in a `CycleStats` given by `getCycleStats()`.
+ * Otherwise `OT_CYCLES_SCOPE` expands to nothing and no member is added: the
+ * generated code is the same as without instrumentation.
+ *
+ * The time source is:
+ * - the DWT cycle counter when `CONTROL_LIB_CYCLES_DWT` is defined (it must
+ *   have been enabled by the application),
+ * - `clock_gettime` in nanoseconds on native_posix and on the host,
+ * - `k_cycle_get_32` else.
+ */
+#ifndef CYCLES_H_
+#define CYCLES_H_
+#include <stdint.h>
+
+#ifdef CONTROL_LIB_CYCLES
+#if defined(CONTROL_LIB_CYCLES_DWT)
+#include <cmsis_core.h>
+#elif defined(CONFIG_ARCH_POSIX) || !defined(__ZEPHYR__)
+#include <time.h>
+#else
+#include <zephyr/kernel.h>
+#endif
+#endif
+
+namespace ot {
+
+/**
+ * @brief current value of the time source used by the instrumentation.
+ */
+static inline uint32_t ot_cycles(void) {
+#if !defined(CONTROL_LIB_CYCLES)
+    return 0;
+#elif defined(CONTROL_LIB_CYCLES_DWT)
+    return DWT->CYCCNT;
+#elif defined(CONFIG_ARCH_POSIX) || !defined(__ZEPHYR__)
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)(now.tv_sec * 1000000000ULL + now.tv_nsec);
+#else
+    return k_cycle_get_32();
+#endif
+}
+
+/**
+ * @class CycleStats
+ * @brief min, max, mean and log2 histogram of durations.
+ *
+ * the bin `k` of the histogram counts the durations `d` with
+ * 2^k <= d < 2^(k+1), the last bin counts all the longer ones.
+ */
+class CycleStats {
+public:
+    static constexpr uint8_t BINS = 16;
+
+    constexpr CycleStats() {};
+
+    void record(uint32_t cycles) {
+        if (cycles < _min) {
+            _min = cycles;
+        }
+        if (cycles > _max) {
+            _max = cycles;
+        }
+        _sum += cycles;
+        _count++;
+        uint8_t bin = (cycles == 0) ? 0 : 31 - __builtin_clz(cycles);
+        if (bin >= BINS) {
+            bin = BINS - 1;
+        }
+        _histogram[bin]++;
+    };
+
+    void reset(void) {
+        *this = CycleStats();
+    };
+
+    uint32_t getMin(void) const {
+        return (_count == 0) ? 0 : _min;
+    };
+
+    uint32_t getMax(void) const {
+        return _max;
+    };
+
+    uint32_t getMean(void) const {
+        return (_count == 0) ? 0 : (uint32_t)(_sum / _count);
+    };
+
+    uint32_t getCount(void) const {
+        return _count;
+    };
+
+    const uint32_t *getHistogram(void) const {
+        return _histogram;
+    };
+
+private:
+    uint32_t _min = UINT32_MAX;
+    uint32_t _max = 0;
+    uint64_t _sum = 0;
+    uint32_t _count = 0;
+    uint32_t _histogram[BINS]{};
+};
+
+/**
+ * @brief records in `stats` the time between its construction and its destruction.
+ */
+class CycleScope {
+public:
+    CycleScope(CycleStats &stats): _stats(stats), _start(ot_cycles()) {};
+
+    ~CycleScope() {
+        _stats.record(ot_cycles() - _start);
+    };
+
+private:
+    CycleStats &_stats;
+    uint32_t _start;
+};
+
+} // namespace ot
+
+#ifdef CONTROL_LIB_CYCLES
+#define OT_CYCLES_SCOPE(stats) ot::CycleScope _cycle_scope(stats)
+#else
+#define OT_CYCLES_SCOPE(stats)
+#endif
+
+#endif
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date 2024
+ * @author Régis Ruelland <regis.ruelland@laas.fr>
+ */
+#include <errno.h>
+#include <math.h>
+#include <zephyr/logging/log.h>
+#include "trigo.h"
+#include "deadbeat.h"
+#include "no_heap.h"
+
+LOG_MODULE_DECLARE(ot_control);
+
+namespace ot {
+
+template <typename T>
+int8_t Deadbeat<T>::init(DeadbeatParams<T> p) {
+    const char *error = checkParams(p);
+    if (error != nullptr) {
+        LOG_ERR("%s", error);
+        return -EINVAL;
+    }
+    this->_Ts = p.Ts;
+    _a = exp(-p.R * p.Ts / p.L);
+    _b = (1 - _a) / p.R;
+    _inverse_b = 1 / _b;
+    _Vmax = p.Vmax;
+    _delay_compensation = p.delay_compensation;
+    setW(p.w);
+    reset();
+    return 0;
+}
+
+template <typename T>
+void Deadbeat<T>::setW(T w) {
+    _cos_wTs = ot_cos(w * this->_Ts);
+    _sin_wTs = ot_sin(w * this->_Ts);
+}
+
+template <typename T>
+void Deadbeat<T>::calculate(void) {
+    OT_CYCLES_SCOPE(this->_cycles);
+    const dqo_t<T> &e = this->_measure.emf;
+    T d = this->_measure.current.d;
+    T q = this->_measure.current.q;
+    if (_delay_compensation) {
+        // current at k+1 with the voltage applied during this period
+        T xd = _a * d + _b * (this->_output.d - e.d);
+        T xq = _a * q + _b * (this->_output.q - e.q);
+        d = _cos_wTs * xd + _sin_wTs * xq;
+        q = _cos_wTs * xq - _sin_wTs * xd;
+    }
+    // v = e + (exp(j w Ts) i* - a i) / b
+    const dqo_t<T> &r = this->_reference;
+    dqo_t<T> v;
+    v.d = e.d + _inverse_b * (_cos_wTs * r.d - _sin_wTs * r.q - _a * d);
+    v.q = e.q + _inverse_b * (_sin_wTs * r.d + _cos_wTs * r.q - _a * q);
+    v.o = 0.0;
+    this->_output = saturate(v);
+    OT_RECORD(this->_recorder, {this->_reference, this->_measure, this->_output, _saturated});
+}
+
+template <typename T>
+dqo_t<T> Deadbeat<T>::saturate(dqo_t<T> u) {
+    T square = u.d * u.d + u.q * u.q;
+    _saturated = square > _Vmax * _Vmax;
+    if (_saturated) {
+        T ratio = _Vmax / sqrt(square);
+        u.d *= ratio;
+        u.q *= ratio;
+    }
+    return u;
+}
+
+template <typename T>
+void Deadbeat<T>::setBounds([[maybe_unused]] dqo_t<T> lower, dqo_t<T> upper) {
+    T Vmax = sqrt(upper.d * upper.d + upper.q * upper.q);
+    if (Vmax > 0.0) {
+        _Vmax = Vmax;
+    }
+}
+
+template <typename T>
+void Deadbeat<T>::reset(void) {
+    this->_output = dqo_t<T>{};
+    _saturated = false;
+}
+
+template class Deadbeat<float32_t>;
+template class Deadbeat<float64_t>;
+
+} // namespace ot
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date 2024
+ * @author Régis Ruelland <regis.ruelland@laas.fr>
+ */
+#ifndef DEADBEAT_H_
+#define DEADBEAT_H_
+#include "controller.h"
+#include "transform.h"
+
+namespace ot {
+
+/**
+ * @class DeadbeatParams
+ * @brief parameters of the deadbeat current controller.
+ *
+ * @param Ts sample time
+ *
+ * @param R resistance of the load, by phase
+ *
+ * @param L inductance of the load, by phase
+ *
+ * @param w pulsation of the dq frame [rad/s]
+ *
+ * @param Vmax max amplitude of the voltage vector, e.g. Vdc / sqrt(3)
+ *
+ * @param delay_compensation the voltage computed at k is applied at k+1 (the
+ * computation takes one period)
+ *
+ * @tparam T scalar type
+ */
+template <typename T = ot_scalar_t>
+struct DeadbeatParams {
+    T Ts;
+    T R;
+    T L;
+    T w;
+    T Vmax;
+    bool delay_compensation;
+};
+
+/**
+ * @class DeadbeatMeasure
+ * @brief measures used by the deadbeat controller, in the dq frame.
+ *
+ * @param current load current
+ *
+ * @param emf back emf of the load (or grid voltage)
+ */
+template <typename T = ot_scalar_t>
+struct DeadbeatMeasure {
+    dqo_t<T> current;
+    dqo_t<T> emf;
+};
+
+/**
+ * @class Deadbeat
+ * @brief deadbeat current controller of an R-L load with back emf in the dq frame.
+ *
+ * The voltage is held in the α, β frame during a period while the dq frame
+ * turns of w Ts, so the discrete model is exactly:
+ *
+ *  i(k+1) = exp(-j w Ts) (a i(k) + b (v(k) - e(k))), a = exp(-R Ts / L), b = (1 - a) / R
+ *
+ * with the dq vectors as complex numbers d + j q. The controller inverts it to
+ * reach the reference at k+1. The output voltage is limited to a circle of
+ * radius `Vmax`, which is the same in the α, β and dq frames.
+ *
+ * With `delay_compensation` the current at k+1 is predicted with the voltage
+ * applied during this period, and the output, to be applied during the next
+ * one (rotated with the angle of k+1), reaches the reference at k+2.
+ */
+template <typename T = ot_scalar_t>
+class Deadbeat: public Controller<dqo_t<T>, DeadbeatMeasure<T>, dqo_t<T>, DeadbeatParams<T>, T> {
+public:
+    Deadbeat() {};
+
+    /**
+     * @return 0 if ok, -EINVAL else.
+     */
+    int8_t init(DeadbeatParams<T> p) override;
+
+    /**
+     * @brief check the parameters of a Deadbeat
+     *
+     * @return nullptr if ok, the error message else.
+     */
+    static constexpr const char *checkParams(DeadbeatParams<T> p) {
+        if (p.Ts <= 0.0 || p.R <= 0.0 || p.L <= 0.0)
+            return "Ts, R and L must be > 0";
+        if (p.Vmax <= 0.0)
+            return "Vmax must be > 0";
+        return nullptr;
+    };
+
+    void calculate(void) override;
+
+    void reset(void) override;
+
+    /**
+     * @brief change the pulsation of the dq frame, e.g. with the speed of a motor.
+     */
+    void setW(T w);
+
+    /**
+     * @brief limit the amplitude of `u` to `Vmax`, keeping its angle.
+     */
+    dqo_t<T> saturate(dqo_t<T> u) override;
+
+    /**
+     * @brief change `Vmax` to the amplitude of `upper`, `lower` is not used.
+     */
+    void setBounds(dqo_t<T> lower, dqo_t<T> upper) override;
+
+    /**
+     * @brief true if the last output has been limited.
+     */
+    bool isSaturated(void) const {
+        return _saturated;
+    };
+
+private:
+    T _a{};
+    T _inverse_b{};
+    T _b{};
+    T _cos_wTs{1.0};
+    T _sin_wTs{};
+    T _Vmax{};
+    bool _delay_compensation{};
+    bool _saturated{};
+};
+
+} // namespace ot
+
+typedef ot::DeadbeatParams<> DeadbeatParams;
+typedef ot::DeadbeatMeasure<> DeadbeatMeasure;
+typedef ot::Deadbeat<> Deadbeat;
+#endif
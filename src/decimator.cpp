@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date 2024
+ * @author Régis Ruelland <regis.ruelland@laas.fr>
+ */
+#include <errno.h>
+#include <zephyr/logging/log.h>
+#include "decimator.h"
+#include "no_heap.h"
+
+LOG_MODULE_DECLARE(ot_control);
+
+namespace ot {
+
+template <typename T>
+int8_t Decimator<T>::init(DecimatorParams<T> p) {
+    if (p.cic_ratio == 0 || p.cic_stages == 0 || p.cic_stages > MAX_STAGES) {
+        LOG_ERR("cic_ratio must be > 0 and cic_stages in [1, %d]", MAX_STAGES);
+        return -EINVAL;
+    }
+    uint64_t gain = 1;
+    for (uint8_t k = 0; k < p.cic_stages; k++) {
+        gain *= p.cic_ratio;
+    }
+    if (gain > (1U << 15)) {
+        LOG_ERR("cic_ratio^cic_stages must be <= 2^15");
+        return -EINVAL;
+    }
+    if (p.fir_ratio == 0 || p.fir_ratio > MAX_FIR_RATIO) {
+        LOG_ERR("fir_ratio must be in [1, %d]", MAX_FIR_RATIO);
+        return -EINVAL;
+    }
+    if (p.nc < p.fir_ratio || p.coeffs == nullptr) {
+        LOG_ERR("at least fir_ratio coefficients are needed");
+        return -EINVAL;
+    }
+    // the phase k has the coefficients k, k + fir_ratio, k + 2 fir_ratio...
+    for (uint8_t phase = 0; phase < p.fir_ratio; phase++) {
+        uint8_t n = (p.nc - phase + p.fir_ratio - 1) / p.fir_ratio;
+        int8_t ret = _phases[phase].init(n, p.coeffs);
+        if (ret != 0) {
+            return ret;
+        }
+        for (uint8_t k = 0; k < n; k++) {
+            _phases[phase].setCoeff(k, p.coeffs[phase + k * p.fir_ratio]);
+        }
+    }
+    _cic_ratio = p.cic_ratio;
+    _cic_stages = p.cic_stages;
+    _fir_ratio = p.fir_ratio;
+    _cic_gain_inverse = T(1.0) / gain;
+    reset();
+    return 0;
+}
+
+template <typename T>
+void Decimator<T>::compensator(uint8_t stages, T (&coeffs)[3]) {
+    T a = T(stages) / 24;
+    coeffs[0] = -a;
+    coeffs[1] = 1 + 2 * a;
+    coeffs[2] = -a;
+}
+
+template <typename T>
+uint16_t Decimator<T>::process(const int32_t *input, uint16_t count, T *output) {
+    uint16_t written = 0;
+    for (uint16_t n = 0; n < count; n++) {
+        // integrators at the input rate, modulo 2^32
+        uint32_t value = static_cast<uint32_t>(input[n]);
+        for (uint8_t k = 0; k < _cic_stages; k++) {
+            _integrators[k] += value;
+            value = _integrators[k];
+        }
+        if (++_cic_count < _cic_ratio) {
+            continue;
+        }
+        _cic_count = 0;
+        // combs at the output rate of the CIC
+        for (uint8_t k = 0; k < _cic_stages; k++) {
+            uint32_t previous = _combs[k];
+            _combs[k] = value;
+            value -= previous;
+        }
+        T sample = static_cast<int32_t>(value) * _cic_gain_inverse;
+        // the last sample of a block of fir_ratio goes to the phase 0
+        _accumulator += _phases[_fir_ratio - 1 - _fir_count].update(sample);
+        if (++_fir_count < _fir_ratio) {
+            continue;
+        }
+        _fir_count = 0;
+        output[written++] = _accumulator;
+        _accumulator = 0.0;
+    }
+    return written;
+}
+
+template <typename T>
+void Decimator<T>::reset(void) {
+    for (uint8_t k = 0; k < MAX_STAGES; k++) {
+        _integrators[k] = 0;
+        _combs[k] = 0;
+    }
+    for (uint8_t phase = 0; phase < _fir_ratio; phase++) {
+        _phases[phase].reset();
+    }
+    _cic_count = 0;
+    _fir_count = 0;
+    _accumulator = 0.0;
+}
+
+template class Decimator<float32_t>;
+template class Decimator<float64_t>;
+
+} // namespace ot
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date 2024
+ * @author Régis Ruelland <regis.ruelland@laas.fr>
+ */
+#ifndef DECIMATOR_H_
+#define DECIMATOR_H_
+#include <stdint.h>
+#include "scalar.h"
+#include "fir.h"
+
+namespace ot {
+
+/**
+ * @class DecimatorParams
+ * @brief parameters of a decimation chain.
+ *
+ * @param cic_ratio decimation ratio of the CIC filter
+ *
+ * @param cic_stages number of integrator and comb stages of the CIC filter,
+ * in [1, 5]
+ *
+ * @param nc number of coefficients of the compensating FIR
+ *
+ * @param coeffs coefficients of the compensating FIR, e.g. given by
+ * `Decimator::compensator`
+ *
+ * @param fir_ratio decimation ratio of the FIR, in [1, 4]
+ *
+ * @tparam T scalar type
+ */
+template <typename T = ot_scalar_t>
+struct DecimatorParams {
+    uint8_t cic_ratio;
+    uint8_t cic_stages;
+    uint8_t nc;
+    const T *coeffs;
+    uint8_t fir_ratio;
+};
+
+/**
+ * @class Decimator
+ * @brief decimation of oversampled ADC samples to the control rate: a CIC
+ * filter followed by a compensating FIR.
+ *
+ * The CIC filter works on integers: its integrators wrap around modulo 2^32,
+ * which gives the exact result as long as it fits in 32 bits, so the samples
+ * multiplied by cic_ratio^cic_stages must stay in [-2^31, 2^31[ (e.g. 16 bits
+ * samples and a gain up to 2^15). Its combs only run at its output rate, and
+ * its gain is removed when its output is converted to `T`.
+ *
+ * The FIR compensates the droop of the CIC in the pass band and decimates by
+ * `fir_ratio` with a polyphase structure: its coefficients are split into
+ * `fir_ratio` `Fir`, each one receiving one sample out of `fir_ratio`, so only
+ * the kept outputs are computed (nc products by output).
+ *
+ * The total decimation ratio is cic_ratio * fir_ratio. A `Decimator` owns its
+ * `Fir`: it can be moved but not copied.
+ *
+ * @tparam T scalar type
+ */
+template <typename T = ot_scalar_t>
+class Decimator {
+public:
+    static constexpr uint8_t MAX_STAGES = 5;
+    static constexpr uint8_t MAX_FIR_RATIO = 4;
+
+    Decimator() {};
+
+    /**
+     * @return 0 if ok, -EINVAL or -ENOMEM else.
+     */
+    int8_t init(DecimatorParams<T> p);
+
+    /**
+     * @brief 3 coefficients [-a, 1 + 2a, -a] compensating the droop of a CIC of
+     * `stages` stages at low frequencies (a = stages / 24).
+     */
+    static void compensator(uint8_t stages, T (&coeffs)[3]);
+
+    /**
+     * @brief filter a block of samples.
+     *
+     * @param input samples at the ADC rate
+     * @param count number of samples
+     * @param output samples at the decimated rate, room for
+     * count / (cic_ratio * fir_ratio) + 1 samples
+     * @return number of samples written in output.
+     */
+    uint16_t process(const int32_t *input, uint16_t count, T *output);
+
+    void reset(void);
+
+private:
+    uint8_t _cic_ratio{};
+    uint8_t _cic_stages{};
+    uint8_t _fir_ratio{};
+    T _cic_gain_inverse{};
+    uint8_t _cic_count{}; // samples since the last CIC output
+    uint8_t _fir_count{}; // CIC outputs since the last FIR output
+    uint32_t _integrators[MAX_STAGES]{};
+    uint32_t _combs[MAX_STAGES]{}; // previous input of each comb
+    T _accumulator{};
+    Fir<T> _phases[MAX_FIR_RATIO];
+};
+
+} // namespace ot
+
+typedef ot::DecimatorParams<> DecimatorParams;
+typedef ot::Decimator<> Decimator;
+#endif
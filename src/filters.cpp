@@ -23,132 +23,194 @@
  */
 
 #include <errno.h>
+#include <math.h>
 #include <zephyr/logging/log.h>
 #include "filters.h"
+#include "no_heap.h"
 LOG_MODULE_DECLARE(ot_control);
 
-LowPassFirstOrderFilter::LowPassFirstOrderFilter(float32_t Ts, float32_t tau) {
-    this->init(Ts, tau);
-}
+namespace ot {
 
-int8_t LowPassFirstOrderFilter::init(float32_t Ts, float32_t tau) {
-    _Ts = Ts;
-    _tau = tau;
-    if (_tau <= 0.0) {
+template <typename T>
+int8_t LowPassFirstOrderFilter<T>::init(T Ts, T tau) {
+    int8_t ret = _setParams(Ts, tau);
+    if (ret != 0) {
         LOG_ERR("tau must be > 0");
-        // we do not filter
-        _a1 = 0.0;
-        _b1 = 1.0;
-        return -EINVAL;
     }
-    float32_t inverse_tau = 1.0 / _tau;
-    // series expansion of -exp(-Ts/τ)
-    _a1 = -(1.0 + (-Ts * inverse_tau) + (-Ts * inverse_tau) * (-Ts * inverse_tau) * 0.5);
-    _b1 = 1 + _a1; 
-    _previous_value = 0.0;
-    return 0;
+    return ret;
 }
 
-float32_t LowPassFirstOrderFilter::calculateWithReturn(float32_t signal) {
-    float32_t value;
+template <typename T>
+T LowPassFirstOrderFilter<T>::calculateWithReturn(T signal) {
+    T value;
     value = _b1 * signal - _a1 * _previous_value;
     _previous_value = value;
+    OT_RECORD(_recorder, {signal, 0, value, 0});
     return value;
 };
 
-void LowPassFirstOrderFilter::reset() {
+template <typename T>
+void LowPassFirstOrderFilter<T>::reset() {
     _previous_value = 0.0F;
 }
 
-void LowPassFirstOrderFilter::reset(float32_t value) {
+template <typename T>
+void LowPassFirstOrderFilter<T>::reset(T value) {
     _previous_value = value;
 }
 
-NotchFilter::NotchFilter(float32_t Ts, float32_t f0, float32_t bandwidth) {
+template <typename T>
+NotchFilter<T>::NotchFilter(T Ts, T f0, T bandwidth) {
     this->init(Ts, f0, bandwidth);
 }
 
-int8_t NotchFilter::init(float32_t Ts, float32_t f0, float32_t bandwidth) {
+template <typename T>
+int8_t NotchFilter<T>::init(T Ts, T f0, T bandwidth) {
+    if (Ts <= 0.0 || bandwidth < 0.0) {
+        LOG_ERR("Ts must be > 0 and bandwidth >= 0");
+        return -EINVAL;
+    }
+    T w0 = 2.0 * ot_pi<T> * f0 * Ts;
+    T deltaW = 2.0 * ot_pi<T> * bandwidth * Ts;
+    T bgain = 1.0 / (1.0 + deltaW * 0.5);
+
+    NotchCoefficients<T> c;
+    c.b[0] = bgain;
+    c.b[1] = -2.0 * bgain * ot_cos(w0);
+    c.b[2] = bgain;
+    c.a[0] = -2.0 * bgain * ot_cos(w0);
+    c.a[1] = 2 * bgain - 1.0;
+    int8_t ret = init(Ts, f0, bandwidth, c);
+    _anchor_sin = ot_sin(w0);
+    return ret;
+}
+
+template <typename T>
+int8_t NotchFilter<T>::init(T Ts, T f0, T bandwidth, const NotchCoefficients<T> &c) {
+    if (Ts <= 0.0 || bandwidth < 0.0 || c.b[0] <= 0.0) {
+        LOG_ERR("Ts must be > 0 and bandwidth >= 0");
+        return -EINVAL;
+    }
     _Ts = Ts;
     _f0 = f0;
     _bandwidth = bandwidth;
+    _gain = c.b[0];
+    _cos_w0 = -c.b[1] / (2.0 * c.b[0]);
+    // 0 <= w0 <= pi below the Nyquist frequency, so sin(w0) >= 0
+    T square = 1.0 - _cos_w0 * _cos_w0;
+    _anchor_w0 = 2.0 * ot_pi<T> * f0 * Ts;
+    _anchor_cos = _cos_w0;
+    _anchor_sin = square > 0.0 ? sqrt(square) : 0.0;
+    _tuning.init(Tuning(c.b[0], c.b[1], c.a[1]));
+    reset();
+    return 0;
+}
 
-    float32_t w0 = 2.0 * PI * _f0 * _Ts;
-    float32_t deltaW = 2.0 * PI * _bandwidth * _Ts;
-    float32_t bgain = 1.0 / (1.0 + deltaW * 0.5);
-
-    float32_t b[3];
-    b[0] = bgain;
-    b[1] = -2.0 * bgain * ot_cos(w0);
-    b[2] = bgain;
-    _B.init(3, b);
+template <typename T>
+T NotchFilter<T>::calculateWithReturn(T signal) {
+    const Tuning &t = _tuning.get(_tuning.acquire());
+    T output = t.gain * (signal + _previous_input[1])
+             + t.cos_gain * (_previous_input[0] - _previous_output[0])
+             - t.pole * _previous_output[1];
+    _tuning.release();
+    _previous_input[1] = _previous_input[0];
+    _previous_input[0] = signal;
+    _previous_output[1] = _previous_output[0];
+    _previous_output[0] = output;
+    OT_RECORD(_recorder, {signal, 0, output, 0});
+    return output;
+}
 
-    float32_t a[2];
-    a[0] = -2.0 * bgain * ot_cos(w0);
-    a[1] = 2 * bgain - 1.0;
-    _A.init(2, a);
+template <typename T>
+void NotchFilter<T>::reset() {
+    _previous_input[0] = 0.0;
+    _previous_input[1] = 0.0;
+    _previous_output[0] = 0.0;
+    _previous_output[1] = 0.0;
+}
 
-    _output = 0.0;
-    return 0;
+template <typename T>
+void NotchFilter<T>::setF0(T f0) {
+    _f0 = f0;
+    T w0 = 2.0 * ot_pi<T> * f0 * _Ts;
+    T delta = w0 - _anchor_w0;
+    if (delta > MAX_DRIFT || delta < -MAX_DRIFT) {
+        _anchor_w0 = w0;
+        _anchor_cos = ot_cos(w0);
+        _anchor_sin = ot_sin(w0);
+        delta = 0.0;
+    }
+    // cos(anchor + delta) with the series of cos(delta) and sin(delta), the
+    // error is below MAX_DRIFT^6 / 720
+    T square = delta * delta;
+    T cos_delta = 1.0 - square * (T(1.0 / 2.0) - square * T(1.0 / 24.0));
+    T sin_delta = delta * (1.0 - square * (T(1.0 / 6.0) - square * T(1.0 / 120.0)));
+    _cos_w0 = _anchor_cos * cos_delta - _anchor_sin * sin_delta;
+    _publish();
 }
 
-float32_t NotchFilter::calculateWithReturn(float32_t signal) {
-    _output =  _B.update(signal) - _A.update(_output);
-    return _output;
+template <typename T>
+void NotchFilter<T>::setBandwidth(T bandwidth) {
+    if (bandwidth >= 0.0) {
+        _bandwidth = bandwidth;
+        _gain = 1.0 / (1.0 + ot_pi<T> * bandwidth * _Ts);
+        _publish();
+    }
 }
 
-void NotchFilter::reset() {
-    _output = 0.0;
-    _B.reset();
-    _A.reset();
+template <typename T>
+void NotchFilter<T>::_publish(void) {
+    Tuning &t = _tuning.edit();
+    t.gain = _gain;
+    t.cos_gain = -2.0 * _gain * _cos_w0;
+    t.pole = 2.0 * _gain - 1.0;
+    _tuning.publish();
 }
 
 /*** Pll *********************************************************************/
 
-PllDatas Pll::calculateWithReturn(float32_t signal) {
-    float32_t error; 
-    float32_t error_filtered;
+template <typename T>
+PllDatas<T> Pll<T>::calculateWithReturn(T signal) {
+    OT_CYCLES_SCOPE(_cycles);
+    T error; 
+    T error_filtered;
     error = _error(signal, _angle);
     error_filtered = _filt_error(error);
     _w = _vco(error);
     _angle = ot_modulo_2pi(_angle + _w * _Ts);
-    return PllDatas(_w, _angle, error_filtered);
+    OT_RECORD(_recorder, {signal, _angle, _w, 0});
+    return PllDatas<T>(_w, _angle, error_filtered);
 }
 
-int8_t Pll::_check_and_get_args(float32_t Ts, float32_t f0, float32_t rise_time) {
-    if (Ts < 0) {
-        LOG_ERR("Ts must be > 0");
+template <typename T>
+int8_t Pll<T>::_check_and_get_args(T Ts, T f0, T rise_time) {
+    const char *error = _check_args(Ts, f0, rise_time);
+    if (error != nullptr) {
+        LOG_ERR("%s", error);
         return -EINVAL;
     }
     _Ts = Ts;
-
-    if (rise_time <= 1.e-6) {
-        LOG_ERR("rise time must be > 0");
-        return -EINVAL;
-    }
     _rt = rise_time;
-
-    if (f0 < 0.0) {
-        LOG_ERR("f0 must be > 0");
-        return -EINVAL;
-    }
     _f0 = f0;
     return 0;
 }
 
-void Pll::reset(float32_t f0=0.0) {
+template <typename T>
+void Pll<T>::reset(T f0) {
     _angle = 0.0;
-    _w = f0 * 2.0 * PI;
+    _w = f0 * 2.0 * ot_pi<T>;
     _pi.reset(_w);
 }
 
 /*** PllSinus ****************************************************************/
-PllSinus::PllSinus(float32_t Ts, float32_t amplitude, float32_t f0, float32_t rt) {
+template <typename T>
+PllSinus<T>::PllSinus(T Ts, T amplitude, T f0, T rt) {
     this->init(Ts, amplitude, f0, rt);
 }
 
-int8_t PllSinus::init(float32_t Ts, float32_t amplitude, float32_t f0, float32_t rise_time) {
-    if (Pll::_check_and_get_args(Ts, f0, rise_time) != 0) {
+template <typename T>
+int8_t PllSinus<T>::init(T Ts, T amplitude, T f0, T rise_time) {
+    if (Pll<T>::_check_and_get_args(Ts, f0, rise_time) != 0) {
         LOG_ERR("arg problems");
         return -EINVAL;
     }
@@ -158,43 +220,55 @@ int8_t PllSinus::init(float32_t Ts, float32_t amplitude, float32_t f0, float32_t
     }
     _amplitude = amplitude;
 
-    _notch.init(_Ts, 2 * _f0, 0.2*_f0);
+    _notch.init(this->_Ts, 2 * this->_f0, 0.2*this->_f0);
+    _notch_f0.init(this->_Ts, 1.0 / this->_f0);
+    _notch_f0.reset(2 * this->_f0);
     _init_pi(rise_time);
     return 0;
 }
 
-float32_t PllSinus::_error(float32_t signal, float32_t angle) {
-    return ot_cos(_angle) * signal;
+template <typename T>
+T PllSinus<T>::_error(T signal, T angle) {
+    return ot_cos(this->_angle) * signal;
     }
 
-float32_t PllSinus::_filt_error(float32_t error) {
+template <typename T>
+T PllSinus<T>::_filt_error(T error) {
+    // the ripple of the error is at twice the tracked frequency, w / pi, kept
+    // within 50 % of its nominal value during the transients. w, driven by the
+    // unfiltered error, has the same ripple: the notch follows its mean over
+    // about a period of f0, not its swings
+    T f = _notch_f0.calculateWithReturn(this->_w * (1.0 / ot_pi<T>));
+    T f_min = this->_f0, f_max = 3.0 * this->_f0;
+    _notch.setF0(f < f_min ? f_min : (f > f_max ? f_max : f));
     return _notch.calculateWithReturn(error);
 }
 
-float32_t PllSinus::_vco(float32_t error) {
-    float32_t value;
-    value  = _pi.calculateWithReturn(error, 0.0);
+template <typename T>
+T PllSinus<T>::_vco(T error) {
+    T value;
+    value  = this->_pi.calculateWithReturn(error, 0.0);
     if (value < 0.0) value = -value;
     return value;
 }
 
-void PllSinus::_init_pi(float32_t rise_time) {
-    float32_t xi = 0.7;
-    float32_t wn  = 3.0/ rise_time;
-    float32_t Kp = 2.0 * wn * xi / _amplitude;
-    float32_t Ti = 2.0 * xi / wn;
-    PidParams pi_params(_Ts, Kp, Ti, 0.0, 0.0, -100.0 * _f0, 100.0 * _f0);
-    _pi.init(pi_params);
+template <typename T>
+void PllSinus<T>::_init_pi(T rise_time) {
+    this->_pi.init(_pi_params(this->_Ts, _amplitude, this->_f0, rise_time));
 }
 
-void PllSinus::reset(float32_t f0=0.0) {
+template <typename T>
+void PllSinus<T>::reset(T f0) {
     _notch.reset();
-    Pll::reset(f0);
+    _notch.setF0(2 * f0);
+    _notch_f0.reset(2 * f0);
+    Pll<T>::reset(f0);
 }
 
 /*** PllAngle ****************************************************************/
-int8_t PllAngle::init(float32_t Ts, float32_t f0, float32_t rise_time) {
-    if (Pll::_check_and_get_args(Ts, f0, rise_time) != 0)
+template <typename T>
+int8_t PllAngle<T>::init(T Ts, T f0, T rise_time) {
+    if (Pll<T>::_check_and_get_args(Ts, f0, rise_time) != 0)
     {
         LOG_ERR("args problem");
         return -EINVAL;
@@ -203,32 +277,37 @@ int8_t PllAngle::init(float32_t Ts, float32_t f0, float32_t rise_time) {
     return 0;
 }
 
-PllAngle::PllAngle(float32_t Ts, float32_t f0, float32_t rt) {
-    this->init(Ts, f0, rt);
-}
-
-float32_t PllAngle::_error(float32_t ref, float32_t mes) {
+template <typename T>
+T PllAngle<T>::_error(T ref, T mes) {
     return ot_sin(ref - mes);
 }
 
-inline float32_t PllAngle::_filt_error(float32_t error) {
+template <typename T>
+inline T PllAngle<T>::_filt_error(T error) {
     return error;
 }
 
-float32_t PllAngle::_vco(float32_t error_filtered) {
-    float32_t value;
-    value  = _pi.calculateWithReturn(error_filtered, 0.0);
+template <typename T>
+T PllAngle<T>::_vco(T error_filtered) {
+    T value;
+    value  = this->_pi.calculateWithReturn(error_filtered, 0.0);
     return value;
 }
 
-void PllAngle::_init_pi(float32_t rise_time) {
-    float32_t xi = 0.7;
-    float32_t wn = 3.0 / rise_time;
-    float32_t Ki = wn * wn;
-    float32_t Kp = 2 * wn * xi;
-    float32_t Ti = Kp / Ki;
-    PidParams pi_params(_Ts, Kp, Ti, 0.0, 0.0, -100.0 * _f0, 100.0 * _f0);
-    _pi.init(pi_params);
+template <typename T>
+void PllAngle<T>::_init_pi(T rise_time) {
+    this->_pi.init(_pi_params(this->_Ts, this->_f0, rise_time));
 }
 
-
+template class LowPassFirstOrderFilter<float32_t>;
+template class LowPassFirstOrderFilter<float64_t>;
+template class NotchFilter<float32_t>;
+template class NotchFilter<float64_t>;
+template class Pll<float32_t>;
+template class Pll<float64_t>;
+template class PllSinus<float32_t>;
+template class PllSinus<float64_t>;
+template class PllAngle<float32_t>;
+template class PllAngle<float64_t>;
+
+} // namespace ot
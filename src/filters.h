@@ -24,30 +24,113 @@
 
 #ifndef FILTERS_H_
 #define FILTERS_H_
+#include <errno.h>
 #include "arm_math_types.h"
 #include "trigo.h" 
-#include "fir.h"
+#include "triple_buffer.h"
 #include "pid.h"
 
+namespace ot {
+
+template <typename T = ot_scalar_t>
 class LowPassFirstOrderFilter {
 public:
-    LowPassFirstOrderFilter(float32_t Ts, float32_t tau);
-    int8_t init(float32_t Ts, float32_t tau);
-    float32_t calculateWithReturn(float32_t signal);
+    constexpr LowPassFirstOrderFilter() {};
+
+    /**
+     * @brief first order low pass filter, can be evaluated at compile time.
+     *
+     * tau <= 0 is a compilation error in a constant expression, at run time it
+     * is logged and the signal is not filtered.
+     *
+     * @param Ts sample time [s]
+     * @param tau time constant [s]
+     */
+    constexpr LowPassFirstOrderFilter(T Ts, T tau) {
+        if (_setParams(Ts, tau) != 0) {
+            ot_invalid_parameters("tau must be > 0");
+        }
+    };
+    int8_t init(T Ts, T tau);
+    T calculateWithReturn(T signal);
     void reset();
-    void reset(float32_t value);
+    void reset(T value);
+#ifdef CONTROL_LIB_RECORDER
+    /**
+     * @brief record each calculation in `recorder`, nullptr to stop.
+     */
+    void setRecorder(Recorder<RecordSample<T>> *recorder) {
+        _recorder = recorder;
+    };
+#endif
 private:
-    float32_t _Ts;
-    float32_t _tau;
-    float32_t _a1;
-    float32_t _b1;
+    constexpr int8_t _setParams(T Ts, T tau) {
+        _Ts = Ts;
+        _tau = tau;
+        if (_tau <= 0.0) {
+            // we do not filter
+            _a1 = 0.0;
+            _b1 = 1.0;
+            return -EINVAL;
+        }
+        T inverse_tau = 1.0 / _tau;
+        // series expansion of -exp(-Ts/τ)
+        _a1 = -(1.0 + (-Ts * inverse_tau) + (-Ts * inverse_tau) * (-Ts * inverse_tau) * 0.5);
+        _b1 = 1 + _a1; 
+        _previous_value = 0.0;
+        return 0;
+    };
 
-    float32_t _previous_value;
+    T _Ts{};
+    T _tau{};
+    T _a1{};
+    T _b1{};
+
+    T _previous_value{};
+#ifdef CONTROL_LIB_RECORDER
+    Recorder<RecordSample<T>> *_recorder = nullptr;
+#endif
+};
+
+/**
+ * @class NotchCoefficients
+ * @brief coefficients of a NotchFilter.
+ *
+ * @param b numerator
+ *
+ * @param a denominator (without the leading 1)
+ *
+ * @tparam T scalar type
+ */
+template <typename T = ot_scalar_t>
+struct NotchCoefficients {
+    T b[3];
+    T a[2];
 };
 
+/**
+ * @class NotchFilter
+ * @brief band stop filter:
+ *
+ *  y(n) = g (x(n) + x(n-2)) - 2 g cos(w0) (x(n-1) - y(n-1)) - (2 g - 1) y(n-2)
+ *
+ * with w0 = 2 pi f0 Ts and g = 1 / (1 + pi bandwidth Ts).
+ *
+ * `setF0` and `setBandwidth` retune it at each sample without resetting its
+ * states, e.g. to follow the frequency estimated by a PLL: cos(w0) is given by
+ * a polynomial around the last w0 computed with `ot_cos` (no trigonometric
+ * call while f0 stays within `MAX_DRIFT` of it) and the coefficients are
+ * triple buffered, so they can be changed from a thread while
+ * `calculateWithReturn` runs in an interrupt.
+ */
+template <typename T = ot_scalar_t>
 class NotchFilter {
 public:
-    NotchFilter() {};
+    // setF0 calls the trigonometric functions beyond this variation of w0 [rad]
+    static constexpr T MAX_DRIFT = 0.05;
+
+    constexpr NotchFilter() {};
+
     /**
      * @brief its a band stop filter
      *
@@ -55,7 +138,7 @@ public:
      * @param f0 central frequency to stop [Hz]
      * @param bandwidth  frequency band [Hz] around f0 where gain < -3dB 
      */
-    NotchFilter(float32_t Ts, float32_t f0, float32_t bandwidth);
+    NotchFilter(T Ts, T f0, T bandwidth);
 
     /**
      * @brief initialize the band stop filter parameters
@@ -64,17 +147,97 @@ public:
      * @param f0 central frequency to stop in [Hz]
      * @param bandwidth  frequency band [Hz] around f0 where gain < -3dB 
      */
-    int8_t init(float32_t Ts, float32_t f0, float32_t bandwidth);
-    float32_t calculateWithReturn(float32_t signal);
+    int8_t init(T Ts, T f0, T bandwidth);
+
+    /**
+     * @brief initialize the band stop filter with precomputed coefficients.
+     *
+     * @param c coefficients given by `coefficients(Ts, f0, bandwidth)`
+     */
+    int8_t init(T Ts, T f0, T bandwidth, const NotchCoefficients<T> &c);
+
+    /**
+     * @brief compute the filter coefficients, can be evaluated at compile time
+     * to avoid any trigonometric call at run time.
+     *
+     * Ts <= 0 or bandwidth < 0 is a compilation error in a constant expression.
+     */
+    static constexpr NotchCoefficients<T> coefficients(T Ts, T f0, T bandwidth) {
+        if (Ts <= 0.0 || bandwidth < 0.0) {
+            ot_invalid_parameters("Ts must be > 0 and bandwidth >= 0");
+        }
+        T w0 = 2.0 * ot_pi<T> * f0 * Ts;
+        T deltaW = 2.0 * ot_pi<T> * bandwidth * Ts;
+        T bgain = 1.0 / (1.0 + deltaW * 0.5);
+        NotchCoefficients<T> c;
+        c.b[0] = bgain;
+        c.b[1] = -2.0 * bgain * ot_constexpr_cos(w0);
+        c.b[2] = bgain;
+        c.a[0] = -2.0 * bgain * ot_constexpr_cos(w0);
+        c.a[1] = 2 * bgain - 1.0;
+        return c;
+    };
+
+    T calculateWithReturn(T signal);
     void reset();
+
+    /**
+     * @brief change the central frequency without resetting the states.
+     *
+     * @param f0 central frequency to stop [Hz]
+     */
+    void setF0(T f0);
+
+    /**
+     * @brief change the bandwidth without resetting the states.
+     *
+     * @param bandwidth frequency band [Hz] around f0 where gain < -3dB, >= 0
+     */
+    void setBandwidth(T bandwidth);
+
+    T getF0(void) const {
+        return _f0;
+    };
+
+    T getBandwidth(void) const {
+        return _bandwidth;
+    };
+#ifdef CONTROL_LIB_RECORDER
+    /**
+     * @brief record each calculation in `recorder`, nullptr to stop.
+     */
+    void setRecorder(Recorder<RecordSample<T>> *recorder) {
+        _recorder = recorder;
+    };
+#endif
 private:
-    float32_t _Ts;
-    float32_t _f0;
-    float32_t _bandwidth;
+    /**
+     * @brief coefficients used by `calculateWithReturn`.
+     */
+    struct Tuning {
+        T gain;        // b0 = b2
+        T cos_gain;    // b1 = a1 = -2 g cos(w0)
+        T pole;        // a2 = 2 g - 1
+    };
+
+    void _publish(void);
 
-    Fir _B; // numerator of the filter
-    Fir _A; // denominator of the filter
-    float32_t _output;
+    T _Ts{};
+    T _f0{};
+    T _bandwidth{};
+    // cos(w0) and the point of its last trigonometric evaluation, for setF0
+    T _cos_w0{};
+    T _anchor_w0{};
+    T _anchor_cos{};
+    T _anchor_sin{};
+    T _gain{};
+
+    TripleBuffer<Tuning> _tuning;
+    T _previous_input[2]{};
+    T _previous_output[2]{};
+#ifdef CONTROL_LIB_RECORDER
+    Recorder<RecordSample<T>> *_recorder = nullptr;
+#endif
 };
 
 /**
@@ -85,33 +248,94 @@ private:
  *
  * @param angle of the tracked signal [rad]
  *
+ * @tparam T scalar type
  */
+template <typename T = ot_scalar_t>
 struct PllDatas {
-    float32_t w;
-    float32_t angle;
-    float32_t error;
+    T w;
+    T angle;
+    T error;
 };
 
+template <typename T = ot_scalar_t>
 class Pll {
 public:
-    Pll() {};
-    PllDatas calculateWithReturn(float32_t signal);
-    virtual void reset(float32_t f0);
+    constexpr Pll() {};
+    PllDatas<T> calculateWithReturn(T signal);
+    virtual void reset(T f0);
+
+    /**
+     * @brief internal signals, e.g. to capture them with a `Scope`.
+     */
+    const T &getW(void) const {
+        return _w;
+    };
+
+    const T &getAngle(void) const {
+        return _angle;
+    };
+#ifdef CONTROL_LIB_CYCLES
+    /**
+     * @brief durations of the `calculateWithReturn` calls.
+     */
+    const CycleStats &getCycleStats(void) const {
+        return _cycles;
+    };
+
+    void resetCycleStats(void) {
+        _cycles.reset();
+    };
+#endif
+#ifdef CONTROL_LIB_RECORDER
+    /**
+     * @brief record each calculation in `recorder`, nullptr to stop.
+     */
+    void setRecorder(Recorder<RecordSample<T>> *recorder) {
+        _recorder = recorder;
+    };
+#endif
 protected:
-    virtual float32_t _error(float32_t ref, float32_t mes) = 0;
-    virtual float32_t _filt_error(float32_t error) = 0;  
-    virtual float32_t _vco(float32_t error) = 0;
-    virtual void _init_pi(float32_t rise_time) = 0;
-    int8_t _check_and_get_args(float32_t Ts, float32_t f0, float32_t rise_time);
-    float32_t _Ts;
-    float32_t _f0;
-    float32_t _rt;
-    Pid _pi;
-    float32_t _w;
-    float32_t _angle;
+    virtual T _error(T ref, T mes) = 0;
+    virtual T _filt_error(T error) = 0;  
+    virtual T _vco(T error) = 0;
+    virtual void _init_pi(T rise_time) = 0;
+    int8_t _check_and_get_args(T Ts, T f0, T rise_time);
+    /**
+     * @return nullptr if the arguments are correct, the error message else.
+     */
+    static constexpr const char *_check_args(T Ts, T f0, T rise_time) {
+        if (Ts < 0)
+            return "Ts must be > 0";
+        if (rise_time <= 1.e-6)
+            return "rise time must be > 0";
+        if (f0 < 0.0)
+            return "f0 must be > 0";
+        return nullptr;
+    };
+    T _Ts{};
+    T _f0{};
+    T _rt{};
+    Pid<T> _pi;
+    T _w{};
+    T _angle{};
+#ifdef CONTROL_LIB_CYCLES
+    CycleStats _cycles;
+#endif
+#ifdef CONTROL_LIB_RECORDER
+    Recorder<RecordSample<T>> *_recorder = nullptr;
+#endif
 };
 
-class PllSinus: public Pll {
+/**
+ * @class PllSinus
+ * @brief phase lock loop on a sinusoidal signal.
+ *
+ * The ripple at twice the frequency of the error is removed by a notch filter
+ * which follows the estimated frequency, low pass filtered over a period of
+ * f0.
+ */
+template <typename T = ot_scalar_t>
+class PllSinus: public Pll<T> {
 public:
     /**
      * @brief a software phase lock loop on a sinusoidal signal 
@@ -122,20 +346,32 @@ public:
      * @param rt rise time of the loop in [s].
      */
     PllSinus() {};
-    PllSinus(float32_t Ts, float32_t amplitude, float32_t f0, float32_t rt);
-    int8_t init(float32_t Ts, float32_t amplitude, float32_t f0, float32_t rt);
-    virtual void reset(float32_t f0) override;
+    PllSinus(T Ts, T amplitude, T f0, T rt);
+    int8_t init(T Ts, T amplitude, T f0, T rt);
+    virtual void reset(T f0) override;
 protected:
-    virtual float32_t _error(float32_t ref, float32_t mes) override;
-    virtual float32_t _filt_error(float32_t error) override;
-    virtual float32_t _vco(float32_t error) override;
-    virtual void _init_pi(float32_t rise_time) override;
+    virtual T _error(T ref, T mes) override;
+    virtual T _filt_error(T error) override;
+    virtual T _vco(T error) override;
+    virtual void _init_pi(T rise_time) override;
+    /**
+     * @brief parameters of the loop pi, can be evaluated at compile time.
+     */
+    static constexpr PidParams<T> _pi_params(T Ts, T amplitude, T f0, T rise_time) {
+        T xi = 0.7;
+        T wn  = 3.0/ rise_time;
+        T Kp = 2.0 * wn * xi / amplitude;
+        T Ti = 2.0 * xi / wn;
+        return PidParams<T>(Ts, Kp, Ti, 0.0, 0.0, -100.0 * f0, 100.0 * f0);
+    };
 private:
-    float32_t _amplitude;
-    NotchFilter _notch;
+    T _amplitude;
+    NotchFilter<T> _notch;
+    LowPassFirstOrderFilter<T> _notch_f0;
 };
 
-class PllAngle: public Pll {
+template <typename T = ot_scalar_t>
+class PllAngle: public Pll<T> {
 public:
     /**
      * @brief a software phase lock loop on a sawtooth signal 
@@ -143,16 +379,49 @@ public:
      * @param Ts sample time in [s]
      * @param f0 mean frequency of the signal to track
      * @param rt rise time of the loop in [s].
+     *
+     * It can be evaluated at compile time (e.g. `constinit PllAngle pll(Ts, f0, rt);`),
+     * then invalid arguments are a compilation error.
      */
-    PllAngle() {};
-    PllAngle(float32_t Ts, float32_t f0, float32_t rt);
-    int8_t init(float32_t Ts, float32_t f0, float32_t rt);
+    constexpr PllAngle() {};
+    constexpr PllAngle(T Ts, T f0, T rt) {
+        const char *error = Pll<T>::_check_args(Ts, f0, rt);
+        if (error != nullptr) {
+            ot_invalid_parameters(error);
+            return;
+        }
+        this->_Ts = Ts;
+        this->_rt = rt;
+        this->_f0 = f0;
+        this->_pi = Pid<T>(_pi_params(Ts, f0, rt));
+    };
+    int8_t init(T Ts, T f0, T rt);
 protected:
-    virtual float32_t _error(float32_t ref, float32_t mes) override;
-    virtual float32_t _filt_error(float32_t error) override;
-    virtual float32_t _vco(float32_t error) override;
-    virtual void _init_pi(float32_t rise_time) override;
+    virtual T _error(T ref, T mes) override;
+    virtual T _filt_error(T error) override;
+    virtual T _vco(T error) override;
+    virtual void _init_pi(T rise_time) override;
+    /**
+     * @brief parameters of the loop pi, can be evaluated at compile time.
+     */
+    static constexpr PidParams<T> _pi_params(T Ts, T f0, T rise_time) {
+        T xi = 0.7;
+        T wn = 3.0 / rise_time;
+        T Ki = wn * wn;
+        T Kp = 2 * wn * xi;
+        T Ti = Kp / Ki;
+        return PidParams<T>(Ts, Kp, Ti, 0.0, 0.0, -100.0 * f0, 100.0 * f0);
+    };
 };
 
+} // namespace ot
+
+typedef ot::LowPassFirstOrderFilter<> LowPassFirstOrderFilter;
+typedef ot::NotchCoefficients<> NotchCoefficients;
+typedef ot::NotchFilter<> NotchFilter;
+typedef ot::PllDatas<> PllDatas;
+typedef ot::Pll<> Pll;
+typedef ot::PllSinus<> PllSinus;
+typedef ot::PllAngle<> PllAngle;
 
 #endif
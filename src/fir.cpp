@@ -24,17 +24,44 @@
 #include "fir.h"
 #include <errno.h>
 #include <zephyr/logging/log.h> 
+#include "no_heap.h"
 LOG_MODULE_REGISTER(ot_control, LOG_LEVEL_DBG);
 //LOG_MODULE_DECLARE(ot_control, LOG_LEVEL_ERR);
 
-Fir::Fir() {
+namespace ot {
+
+template <typename T>
+Fir<T>::Fir() {
 }
 
-Fir::Fir(const uint8_t nc, const float *coefficients) {
+template <typename T>
+Fir<T>::Fir(const uint8_t nc, const T *coefficients) {
     init(nc, coefficients);
 }
 
-uint8_t Fir::init(uint8_t nc, const float *coefficients) {
+template <typename T>
+Fir<T>::Fir(Fir &&other) {
+    *this = static_cast<Fir &&>(other);
+}
+
+template <typename T>
+Fir<T> &Fir<T>::operator=(Fir &&other) {
+    if (this != &other) {
+        _release();
+        nc = other.nc;
+        capacity = other.capacity;
+        coeffs = other.coeffs;
+        datas = other.datas;
+        other.nc = 0;
+        other.capacity = 0;
+        other.coeffs = nullptr;
+        other.datas = nullptr;
+    }
+    return *this;
+}
+
+template <typename T>
+int8_t Fir<T>::init(uint8_t nc, const T *coefficients) {
     if (nc == 0) {
         LOG_ERR("erreur nc = 0");
         return -EINVAL;
@@ -44,19 +71,31 @@ uint8_t Fir::init(uint8_t nc, const float *coefficients) {
         return -EINVAL;
     }
 
+    if (nc > capacity) {
+        _release();
+        T *buffer = _allocate(nc);
+        if (buffer == nullptr) {
+            LOG_ERR("no memory for %d coefficients", nc);
+            this->nc = 0;
+            return -ENOMEM;
+        }
+        this->coeffs = buffer;
+        this->datas = buffer + nc;
+        this->capacity = nc;
+    }
     this->nc = nc;
-    this->coeffs = new float32_t [nc];
-    this->datas = new float32_t [nc]();
 
     for (uint8_t k=0; k < nc; k++) {
+        this->datas[k] = 0.0;
         this->coeffs[k] = coefficients[k];
         LOG_DBG("coeffs[%d] = %f\n", k, this->coeffs[k]);
     }
     return 0;
 }
 
-float32_t Fir::update(float32_t new_data) {
-    float32_t new_value = 0;
+template <typename T>
+T Fir<T>::update(T new_data) {
+    T new_value = 0;
     datas[0] = new_data;
     new_value = coeffs[0] * datas[0];
     for (uint8_t k = nc-1; k > 0; k--)
@@ -67,23 +106,52 @@ float32_t Fir::update(float32_t new_data) {
     return new_value;
 }
 
-void Fir::reset(){
+template <typename T>
+void Fir<T>::reset(){
     for (uint8_t k=0; k < nc; k++) {
         datas[k] = 0.0;
     }
 }
 
-Fir::~Fir() {
-    if (coeffs != nullptr)
+template <typename T>
+Fir<T>::~Fir() {
+    _release();
+}
+
+template <typename T>
+T *Fir<T>::_allocate(uint8_t n) {
+    T *buffer = static_cast<T *>(controlLibArena.allocate(2 * n * sizeof(T), alignof(T)));
+#ifndef CONTROL_LIB_NO_HEAP
+    if (buffer == nullptr) {
+        buffer = new T [2 * n];
+    }
+#endif
+    return buffer;
+}
+
+template <typename T>
+void Fir<T>::_release() {
+    if (coeffs != nullptr && controlLibArena.owns(coeffs)) {
+        controlLibArena.deallocate(coeffs, 2 * capacity * sizeof(T));
+    } else if (coeffs != nullptr) {
+#ifndef CONTROL_LIB_NO_HEAP
         delete[] coeffs;
-    if (datas != nullptr)
-        delete[] datas;
+#endif
+    }
+    coeffs = nullptr;
+    datas = nullptr;
+    capacity = 0;
+    nc = 0;
 }
 
-void Fir::setCoeff(uint8_t n, float32_t value) {
+template <typename T>
+void Fir<T>::setCoeff(uint8_t n, T value) {
     if (n < nc && n >= 0) {
         this->coeffs[n] = value;
     }
 }
 
+template class Fir<float32_t>;
+template class Fir<float64_t>;
 
+} // namespace ot
@@ -24,6 +24,10 @@
 #ifndef FIR_H_
 #define FIR_H_
 #include <arm_math.h>
+#include "scalar.h"
+#include "arena.h"
+
+namespace ot {
 
 /**
  * @class Fir
@@ -32,26 +36,47 @@
  * @param nc number of coefficients
  *
  * @param *coeffs pointer to array of coefficients
+ *
+ * The coefficients and the datas are carved in one block from `controlLibArena`.
+ * Calling `init` again with a number of coefficients lower or equal to the
+ * first one re-uses this block, a bigger one gives it back to the arena, as
+ * the destructor does.
+ *
+ * A Fir owns its storage: it can be moved but not copied.
+ *
+ * @tparam T scalar type
  */
+template <typename T = ot_scalar_t>
 class Fir {
 public:
     Fir();
-    Fir(const uint8_t nc, const float32_t *coeffs);
+    Fir(const uint8_t nc, const T *coeffs);
+    Fir(const Fir &) = delete;
+    Fir &operator=(const Fir &) = delete;
+    Fir(Fir &&other);
+    Fir &operator=(Fir &&other);
     /**
      * @brief method to initialize the Fir with its coefficients
      *
      * @param nc  number of coefficients
      * @param coeffs pointer to array of coefficients
-     * @return 
+     * @return 0 if ok, -EINVAL or -ENOMEM else.
      */
-    uint8_t init(uint8_t nc, const float32_t *coeffs);
-    float32_t update(float32_t new_data);
+    int8_t init(uint8_t nc, const T *coeffs);
+    T update(T new_data);
     void reset();
-    void setCoeff(uint8_t n, float32_t value);
+    void setCoeff(uint8_t n, T value);
     ~Fir();
 private:
-    uint8_t nc;
-    float32_t *coeffs;
-    float32_t *datas;
+    T *_allocate(uint8_t n);
+    void _release();
+    uint8_t nc = 0;
+    uint8_t capacity = 0;
+    T *coeffs = nullptr;
+    T *datas = nullptr;
 };
+
+} // namespace ot
+
+typedef ot::Fir<> Fir;
 #endif
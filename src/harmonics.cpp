@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date 2024
+ * @author Régis Ruelland <regis.ruelland@laas.fr>
+ */
+#include <errno.h>
+#include <math.h>
+#include <zephyr/logging/log.h>
+#include "trigo.h"
+#include "harmonics.h"
+#include "no_heap.h"
+
+LOG_MODULE_DECLARE(ot_control);
+
+namespace ot {
+
+template <typename T>
+int8_t HarmonicAnalyzer<T>::init(T Ts, const uint8_t *orders, uint8_t count) {
+    if (Ts <= 0.0) {
+        LOG_ERR("Ts must be > 0");
+        return -EINVAL;
+    }
+    if (orders == nullptr || count == 0 || count > MAX_HARMONICS) {
+        LOG_ERR("1 to %d harmonics", MAX_HARMONICS);
+        return -EINVAL;
+    }
+    uint8_t previous = 0;
+    uint8_t largest_gap = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        if (orders[i] <= previous || orders[i] > MAX_ORDER) {
+            LOG_ERR("orders must be increasing in [1, %d]", MAX_ORDER);
+            return -EINVAL;
+        }
+        _orders[i] = orders[i];
+        _gaps[i] = orders[i] - previous;
+        largest_gap = _gaps[i] > largest_gap ? _gaps[i] : largest_gap;
+        previous = orders[i];
+    }
+    _squarings = 0;
+    while ((largest_gap >> _squarings) != 0) {
+        _squarings++;
+    }
+    _Ts = Ts;
+    _count = count;
+    reset();
+    return 0;
+}
+
+template <typename T>
+void HarmonicAnalyzer<T>::update(T x, T angle) {
+    if (angle < _previous_angle - ot_pi<T>) {
+        // a new turn: publish the period which ends
+        if (_synchronized) {
+            _mailbox.post(_sums);
+        }
+        _sums = Sums{};
+        _synchronized = true;
+    }
+    _previous_angle = angle;
+    if (!_synchronized) {
+        return;
+    }
+    // exp(j 2^i angle)
+    T c[6], s[6];
+    c[0] = ot_cos(angle);
+    s[0] = ot_sin(angle);
+    for (uint8_t i = 1; i < _squarings; i++) {
+        c[i] = c[i - 1] * c[i - 1] - s[i - 1] * s[i - 1];
+        s[i] = 2 * c[i - 1] * s[i - 1];
+    }
+    // exp(j order angle), from the previous order
+    T power_c = 1.0, power_s = 0.0;
+    for (uint8_t h = 0; h < _count; h++) {
+        uint8_t gap = _gaps[h];
+        for (uint8_t i = 0; gap != 0; i++, gap >>= 1) {
+            if (gap & 1) {
+                T next_c = power_c * c[i] - power_s * s[i];
+                power_s = power_c * s[i] + power_s * c[i];
+                power_c = next_c;
+            }
+        }
+        _sums.cos_sum[h] += x * power_c;
+        _sums.sin_sum[h] += x * power_s;
+    }
+    _sums.sum += x;
+    _sums.square_sum += x * x;
+    _sums.samples++;
+}
+
+template <typename T>
+bool HarmonicAnalyzer<T>::getResults(HarmonicResults<T> &results) {
+    if (!_mailbox.take(_read) || _read.samples == 0) {
+        return false;
+    }
+    T inverse_n = T(1.0) / _read.samples;
+    results.count = _count;
+    for (uint8_t h = 0; h < _count; h++) {
+        results.order[h] = _orders[h];
+        results.amplitude[h] = 2 * inverse_n * sqrt(_read.cos_sum[h] * _read.cos_sum[h]
+                                                    + _read.sin_sum[h] * _read.sin_sum[h]);
+        results.phase[h] = atan2(_read.cos_sum[h], _read.sin_sum[h]);
+    }
+    results.dc = _read.sum * inverse_n;
+    T square = _read.square_sum * inverse_n;
+    results.rms = sqrt(square);
+    results.thd = 0.0;
+    if (_orders[0] == 1 && results.amplitude[0] > 0.0) {
+        T distortion = 0.0;
+        for (uint8_t h = 1; h < _count; h++) {
+            distortion += results.amplitude[h] * results.amplitude[h];
+        }
+        results.thd = sqrt(distortion) / results.amplitude[0];
+    }
+    results.frequency = inverse_n / _Ts;
+    return true;
+}
+
+template <typename T>
+void HarmonicAnalyzer<T>::reset(void) {
+    _synchronized = false;
+    _previous_angle = 0.0;
+    _sums = Sums{};
+}
+
+template class HarmonicAnalyzer<float32_t>;
+template class HarmonicAnalyzer<float64_t>;
+
+} // namespace ot
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date 2024
+ * @author Régis Ruelland <regis.ruelland@laas.fr>
+ */
+#ifndef HARMONICS_H_
+#define HARMONICS_H_
+#include <stdint.h>
+#include "scalar.h"
+#include "mailbox.h"
+
+namespace ot {
+
+/**
+ * @class HarmonicResults
+ * @brief analysis of one fundamental period.
+ *
+ * @param count number of analyzed harmonics
+ *
+ * @param order order of each harmonic (1 for the fundamental)
+ *
+ * @param amplitude peak amplitude of each harmonic
+ *
+ * @param phase phase of each harmonic [rad]: the harmonic is
+ * amplitude * sin(order * angle + phase), angle being the angle of the PLL
+ *
+ * @param dc mean value
+ *
+ * @param rms root mean square value, all harmonics included
+ *
+ * @param thd total harmonic distortion of the analyzed harmonics, 0 if the
+ * fundamental is not analyzed
+ *
+ * @param frequency fundamental frequency [Hz] given by the length of the period
+ *
+ * @tparam T scalar type
+ */
+template <typename T = ot_scalar_t>
+struct HarmonicResults {
+    static constexpr uint8_t MAX_HARMONICS = 16;
+
+    uint8_t count;
+    uint8_t order[MAX_HARMONICS];
+    T amplitude[MAX_HARMONICS];
+    T phase[MAX_HARMONICS];
+    T dc;
+    T rms;
+    T thd;
+    T frequency;
+};
+
+/**
+ * @class HarmonicAnalyzer
+ * @brief streaming analysis of the harmonics of a signal synchronized on the
+ * angle of a PLL (`PllSinus` or `PllAngle`).
+ *
+ * `update` is called in the control loop with each sample and the angle of the
+ * PLL, in [0, 2π[. It accumulates x sin(h angle) and x cos(h angle) for the
+ * chosen harmonics h (a DFT whose bins follow the angle): the powers of
+ * exp(j angle) are obtained by products, one `ot_sin` and one `ot_cos` being
+ * called by sample, so the cost is O(number of harmonics).
+ *
+ * The window being exactly one period of the PLL, a frequency away from its
+ * nominal value does not leak to the other bins. At each turn of the angle the
+ * sums are posted in a mailbox and `getResults` computes, in the context of the
+ * reader (a thread), the amplitudes, phases, rms and THD of the last period.
+ *
+ * @tparam T scalar type
+ */
+template <typename T = ot_scalar_t>
+class HarmonicAnalyzer {
+public:
+    static constexpr uint8_t MAX_HARMONICS = HarmonicResults<T>::MAX_HARMONICS;
+    static constexpr uint8_t MAX_ORDER = 63;
+
+    HarmonicAnalyzer() {};
+
+    /**
+     * @param Ts sample time
+     * @param orders orders of the harmonics, increasing, in [1, MAX_ORDER]
+     * @param count number of harmonics, up to MAX_HARMONICS
+     * @return 0 if ok, -EINVAL else.
+     */
+    int8_t init(T Ts, const uint8_t *orders, uint8_t count);
+
+    /**
+     * @brief accumulate a new sample, in the control loop.
+     *
+     * @param x signal
+     * @param angle angle of the fundamental given by the PLL, in [0, 2π[
+     */
+    void update(T x, T angle);
+
+    /**
+     * @brief results of the last complete period, from another context.
+     *
+     * @param results left unchanged if no period has been completed since the
+     * last call.
+     * @return true if `results` has been updated.
+     */
+    bool getResults(HarmonicResults<T> &results);
+
+    /**
+     * @brief forget the current period, the next one begins at the next turn of
+     * the angle.
+     */
+    void reset(void);
+
+private:
+    struct Sums {
+        T cos_sum[MAX_HARMONICS];
+        T sin_sum[MAX_HARMONICS];
+        T sum;
+        T square_sum;
+        uint32_t samples;
+    };
+
+    T _Ts{};
+    uint8_t _count{};
+    uint8_t _orders[MAX_HARMONICS]{};
+    uint8_t _gaps[MAX_HARMONICS]{}; // order - previous order
+    uint8_t _squarings{}; // number of bits of the largest gap
+    bool _synchronized{};
+    T _previous_angle{};
+    Sums _sums{};
+    Mailbox<Sums> _mailbox;
+    Sums _read{};
+};
+
+} // namespace ot
+
+typedef ot::HarmonicResults<> HarmonicResults;
+typedef ot::HarmonicAnalyzer<> HarmonicAnalyzer;
+#endif
@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date 2024
+ * @author Régis Ruelland <regis.ruelland@laas.fr>
+ *
+ * Adaptive filters: LMS and normalized LMS.
+ */
+#ifndef LMS_H_
+#define LMS_H_
+#include <errno.h>
+#include <stddef.h>
+#include <array>
+#include "controller.h"
+
+namespace ot {
+
+/**
+ * @class LmsParams
+ * @brief step size and variants of an adaptive filter.
+ *
+ * @param mu step size, > 0. For a `NlmsFilter` it is normalized by the power
+ * of the reference: it converges for 0 < mu < 2.
+ *
+ * @param leakage weights are multiplied by 1 - mu leakage at each update, to
+ * forget the part of the weights which is no more excited (0: no leakage).
+ *
+ * @param epsilon added to the power of the reference by a `NlmsFilter`, to
+ * bound the step when the reference vanishes.
+ *
+ * @param sign_error update the weights with the sign of the error instead of
+ * the error: less sensitive to outliers, at the price of a slower convergence.
+ *
+ * @tparam T scalar type
+ */
+template <typename T = ot_scalar_t>
+struct LmsParams {
+    T mu;
+    T leakage = 0.0;
+    T epsilon = 1e-6;
+    bool sign_error = false;
+};
+
+/**
+ * @class LmsFilter
+ * @brief adaptive FIR filter: the weights w follow the Least Mean Squares of
+ * the error between a desired signal d and the filtered reference x.
+ *
+ *  y(n)   = w(n) x(n)
+ *  e(n)   = d(n) - y(n)
+ *  w(n+1) = (1 - mu leakage) w(n) + mu e(n) x(n)
+ *
+ * To cancel a ripple of a measure d, the reference is correlated with the
+ * ripple, e.g. sin and cos of the angle of a PLL for a harmonic whose
+ * frequency drifts with the load: `update` returns e, the measure without
+ * the ripple, and the weights track the amplitude and phase of the ripple.
+ *
+ * The update of the weights by e(n) is done at the next sample, in the same
+ * loop over the taps as the next output: one pass of 2 N products by sample,
+ * 3 N for the leaky and normalized variants, with a static storage. The
+ * outputs are the same as with the update done at once.
+ *
+ * The reference is either a signal whose N last samples are the regressor
+ * (`update(x, d)`, an adaptive FIR) or N signals given at each sample
+ * (`update(std::array x, d)`); an instance uses one of them until `reset`.
+ *
+ * @tparam N number of weights
+ * @tparam T scalar type
+ * @tparam NORMALIZED the step is divided by epsilon + |x(n)|², see `NlmsFilter`
+ */
+template <size_t N, typename T = ot_scalar_t, bool NORMALIZED = false>
+class LmsFilter {
+public:
+    typedef std::array<T, N> Weights;
+    typedef std::array<T, N> Reference;
+
+    static_assert(N > 0, "an adaptive filter needs at least one weight");
+
+    constexpr LmsFilter() {};
+
+    /**
+     * @brief initialize the filter with zero weights.
+     *
+     * @return 0 if ok, -EINVAL else.
+     */
+    int8_t init(LmsParams<T> p) {
+        int8_t error = setParams(p);
+        if (error == 0) {
+            reset();
+        }
+        return error;
+    };
+
+    /**
+     * @brief check the parameters of a LmsFilter
+     *
+     * @return nullptr if ok, the error message else.
+     */
+    static constexpr const char *checkParams(LmsParams<T> p) {
+        if (!(p.mu > 0.0))
+            return "mu must be > 0";
+        if (NORMALIZED && !(p.mu < 2.0))
+            return "mu must be < 2 for a normalized LMS";
+        if (p.leakage < 0.0 || !(p.mu * p.leakage < 1.0))
+            return "leakage must be >= 0 and < 1 / mu";
+        if (p.epsilon < 0.0)
+            return "epsilon must be >= 0";
+        return nullptr;
+    };
+
+    /**
+     * @brief change the step size and the variants without resetting the weights.
+     *
+     * @return 0 if ok, -EINVAL else.
+     */
+    int8_t setParams(LmsParams<T> p) {
+        const char *error = checkParams(p);
+        if (error != nullptr) {
+            ot_invalid_parameters(error);
+            return -EINVAL;
+        }
+        _mu = p.mu;
+        _forget = 1.0 - p.mu * p.leakage;
+        _epsilon = p.epsilon;
+        _sign_error = p.sign_error;
+        return 0;
+    };
+
+    /**
+     * @brief zero the weights and the reference.
+     */
+    void reset(void) {
+        _weights.fill(0.0);
+        _line.fill(0.0);
+        _head = N + 1;
+        _step = 0.0;
+        _estimate = 0.0;
+        _error = 0.0;
+    };
+
+    /**
+     * @brief adaptive FIR: the regressor is x(n), x(n-1) ... x(n-N+1).
+     *
+     * @param x new sample of the reference
+     * @param d new sample of the desired signal
+     * @return the error d - y
+     */
+    T update(T x, T d) {
+        // x is written twice, so the last N + 1 samples are contiguous from _head
+        _head = (_head == 0) ? N : _head - 1;
+        _line[_head] = x;
+        _line[_head + N + 1] = x;
+        const T *window = &_line[_head];
+        // the previous regressor is the current one shifted by one sample
+        return _filter<false>(window, window + 1, nullptr, d);
+    };
+
+    /**
+     * @brief the regressor is given at each sample, e.g. sin and cos of harmonics.
+     *
+     * @param x new values of the N reference signals
+     * @param d new sample of the desired signal
+     * @return the error d - y
+     */
+    T update(const Reference &x, T d) {
+        // the previous regressor is kept at the beginning of the line
+        return _filter<true>(x.data(), &_line[0], &_line[0], d);
+    };
+
+    /**
+     * @brief weights used by the last output.
+     */
+    const Weights &getWeights(void) const {
+        return _weights;
+    };
+
+    /**
+     * @brief filtered reference y, the estimation of d.
+     */
+    const T &getEstimate(void) const {
+        return _estimate;
+    };
+
+    /**
+     * @brief error e = d - y, also returned by `update`.
+     */
+    const T &getError(void) const {
+        return _error;
+    };
+
+private:
+    template <bool STORE>
+    T _filter(const T *x, const T *previous, T *store, T d) {
+        T power = 0.0;
+        T y = (_forget == 1.0) ? _pass<false, STORE>(x, previous, store, power)
+                               : _pass<true, STORE>(x, previous, store, power);
+        return _adapt(y, power, d);
+    };
+
+    /**
+     * @brief updates the weights by the previous error and computes the output.
+     *
+     * @tparam LEAKY the weights are multiplied by _forget
+     * @tparam STORE the regressor is copied to store for the next update
+     */
+    template <bool LEAKY, bool STORE>
+    T _pass(const T *x, const T *previous, T *store, T &power) {
+        T y = 0.0;
+        const T step = _step;
+        for (size_t k = 0; k < N; k++) {
+            T w = LEAKY ? _forget * _weights[k] : _weights[k];
+            w += step * previous[k];
+            _weights[k] = w;
+            y += w * x[k];
+            if constexpr (NORMALIZED) {
+                power += x[k] * x[k];
+            }
+            if constexpr (STORE) {
+                store[k] = x[k];
+            }
+        }
+        return y;
+    };
+
+    /**
+     * @brief error of the new output and step of the next update of the weights.
+     */
+    T _adapt(T y, T power, T d) {
+        T e = d - y;
+        _estimate = y;
+        _error = e;
+        T gain = e;
+        if (_sign_error) {
+            gain = (e > 0.0) ? 1.0 : ((e < 0.0) ? -1.0 : 0.0);
+        }
+        if constexpr (NORMALIZED) {
+            _step = _mu * gain / (_epsilon + power);
+        } else {
+            _step = _mu * gain;
+        }
+        return e;
+    };
+
+    Weights _weights{};
+    // reference written twice from _head and _head + N + 1, or previous regressor
+    std::array<T, 2 * (N + 1)> _line{};
+    size_t _head = N + 1;
+    T _step{}; // mu e(n-1), applied to the previous regressor
+    T _mu{};
+    T _forget = 1.0; // 1 - mu leakage
+    T _epsilon{};
+    bool _sign_error = false;
+    T _estimate{};
+    T _error{};
+};
+
+/**
+ * @brief normalized LMS: the step is mu / (epsilon + |x(n)|²), so the
+ * convergence does not depend on the amplitude of the reference.
+ */
+template <size_t N, typename T = ot_scalar_t>
+using NlmsFilter = LmsFilter<N, T, true>;
+
+} // namespace ot
+
+typedef ot::LmsParams<> LmsParams;
+#endif
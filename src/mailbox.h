@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date 2024
+ * @author Régis Ruelland <regis.ruelland@laas.fr>
+ */
+#ifndef MAILBOX_H_
+#define MAILBOX_H_
+#include <stdint.h>
+#include "triple_buffer.h"
+
+namespace ot {
+
+/**
+ * @class Mailbox
+ * @brief pass the last value of `V` from one writer to one reader running in
+ * another context (a thread and an interrupt).
+ *
+ * It is a `TripleBuffer` of values: `post` publishes a new value and `take`
+ * acquires it when one has been posted. Both sides only do one atomic exchange:
+ * they never wait and the reader never sees a partially written value.
+ * Intermediate values posted between two `take` are lost, only the last one is
+ * read.
+ *
+ * @tparam V type of the value.
+ */
+template <typename V>
+class Mailbox {
+public:
+    constexpr Mailbox() {};
+
+    /**
+     * @brief writer side: publish a new value.
+     */
+    void post(const V &value) {
+        _values.publish(value);
+    };
+
+    /**
+     * @brief reader side: get the last value posted.
+     *
+     * @param value is left unchanged when nothing new has been posted.
+     * @return true if `value` has been updated.
+     */
+    bool take(V &value) {
+        if (!_values.fresh()) {
+            return false;
+        }
+        value = _values.get(_values.acquire());
+        return true;
+    };
+
+private:
+    TripleBuffer<V> _values;
+};
+
+} // namespace ot
+
+#endif
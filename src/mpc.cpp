@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date 2024
+ * @author Régis Ruelland <regis.ruelland@laas.fr>
+ */
+#include <errno.h>
+#include <math.h>
+#include <zephyr/logging/log.h>
+#include "mpc.h"
+#include "no_heap.h"
+
+LOG_MODULE_DECLARE(ot_control);
+
+namespace ot {
+
+template <typename T>
+int8_t FcsMpc<T>::init(FcsMpcParams<T> p) {
+    const char *error = checkParams(p);
+    if (error != nullptr) {
+        LOG_ERR("%s", error);
+        return -EINVAL;
+    }
+    this->_Ts = p.Ts;
+    this->_lower_bound = 0;
+    this->_upper_bound = STATES - 1;
+    _a = exp(-p.R * p.Ts / p.L);
+    _b = (1 - _a) / p.R;
+    _lambda = p.lambda;
+    _delay_compensation = p.delay_compensation;
+    setVdc(p.Vdc);
+    reset();
+    return 0;
+}
+
+template <typename T>
+clarke_t<T> FcsMpc<T>::getVoltage(uint8_t state) const {
+    T sa = (state & 1) ? 1.0 : 0.0;
+    T sb = (state & 2) ? 1.0 : 0.0;
+    T sc = (state & 4) ? 1.0 : 0.0;
+    // phase to neutral voltages of a balanced load
+    three_phase_t<T> v{_Vdc / 3 * (2 * sa - sb - sc),
+                       _Vdc / 3 * (2 * sb - sa - sc),
+                       _Vdc / 3 * (2 * sc - sa - sb)};
+    return Transform<T>::clarke(v);
+}
+
+template <typename T>
+void FcsMpc<T>::setVdc(T Vdc) {
+    _Vdc = Vdc;
+    for (uint8_t state = 0; state < STATES; state++) {
+        clarke_t<T> v = getVoltage(state);
+        _bv_alpha[state] = _b * v.alpha;
+        _bv_beta[state] = _b * v.beta;
+    }
+}
+
+template <typename T>
+void FcsMpc<T>::calculate(void) {
+    OT_CYCLES_SCOPE(this->_cycles);
+    clarke_t<T> i = Transform<T>::clarke(this->_measure.currents);
+    T free_alpha = _a * i.alpha - _b * this->_measure.emf.alpha;
+    T free_beta = _a * i.beta - _b * this->_measure.emf.beta;
+    uint8_t previous = this->_output;
+    if (_delay_compensation) {
+        // current at k+1 with the state applied during this period
+        i.alpha = free_alpha + _bv_alpha[previous];
+        i.beta = free_beta + _bv_beta[previous];
+        free_alpha = _a * i.alpha - _b * this->_measure.emf.alpha;
+        free_beta = _a * i.beta - _b * this->_measure.emf.beta;
+    }
+    T error_alpha = this->_reference.alpha - free_alpha;
+    T error_beta = this->_reference.beta - free_beta;
+
+    T costs[STATES];
+    for (uint8_t state = 0; state < STATES; state++) {
+        T ea = error_alpha - _bv_alpha[state];
+        T eb = error_beta - _bv_beta[state];
+        T commutations = __builtin_popcount(state ^ previous);
+        costs[state] = ea * ea + eb * eb + _lambda * commutations;
+    }
+    // branchless argmin: selects are compiled as conditional moves
+    uint8_t best = 0;
+    T best_cost = costs[0];
+    for (uint8_t state = 1; state < STATES; state++) {
+        bool lower = costs[state] < best_cost;
+        best = lower ? state : best;
+        best_cost = lower ? costs[state] : best_cost;
+    }
+    _prediction.alpha = free_alpha + _bv_alpha[best];
+    _prediction.beta = free_beta + _bv_beta[best];
+    this->_output = best;
+    OT_RECORD(this->_recorder, {this->_reference, this->_measure, best, 0});
+}
+
+template <typename T>
+void FcsMpc<T>::reset(void) {
+    this->_output = 0;
+    _prediction = clarke_t<T>{};
+}
+
+template class FcsMpc<float32_t>;
+template class FcsMpc<float64_t>;
+
+} // namespace ot
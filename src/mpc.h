@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date 2024
+ * @author Régis Ruelland <regis.ruelland@laas.fr>
+ */
+#ifndef MPC_H_
+#define MPC_H_
+#include "controller.h"
+#include "transform.h"
+
+namespace ot {
+
+/**
+ * @class FcsMpcParams
+ * @brief parameters of the finite control set model predictive controller.
+ *
+ * @param Ts sample time
+ *
+ * @param R resistance of the load, by phase
+ *
+ * @param L inductance of the load, by phase
+ *
+ * @param Vdc dc bus voltage of the inverter
+ *
+ * @param lambda weight of the number of commutations in the cost, 0 to
+ * only track the current
+ *
+ * @param delay_compensation predict two steps ahead: the state chosen at k
+ * is applied at k+1 (the computation takes one period)
+ *
+ * @tparam T scalar type
+ */
+template <typename T = ot_scalar_t>
+struct FcsMpcParams {
+    T Ts;
+    T R;
+    T L;
+    T Vdc;
+    T lambda;
+    bool delay_compensation;
+};
+
+/**
+ * @class FcsMpcMeasure
+ * @brief measures used by the prediction.
+ *
+ * @param currents load currents
+ *
+ * @param emf back emf of the load (or grid voltage) in the α, β frame
+ */
+template <typename T = ot_scalar_t>
+struct FcsMpcMeasure {
+    three_phase_t<T> currents;
+    clarke_t<T> emf;
+};
+
+/**
+ * @class FcsMpc
+ * @brief finite control set model predictive current controller of a two
+ * level inverter on an R-L load with back emf.
+ *
+ * The reference is the load current in the α, β frame. At each period the
+ * current is predicted for the 8 switching states of the inverter:
+ *
+ *  i(k+1) = a i(k) + b (v - e(k)), a = exp(-R Ts / L), b = (1 - a) / R
+ *
+ * and the state minimizing |i* - i(k+1)|² + lambda * commutations is the
+ * output: bit 0 for the leg a, bit 1 for b and bit 2 for c. The voltage
+ * vectors multiplied by b are computed by `init`.
+ *
+ * With `delay_compensation`, the current at k+1 is first predicted with the
+ * state applied during the current period, then the choice is made on k+2.
+ */
+template <typename T = ot_scalar_t>
+class FcsMpc: public Controller<clarke_t<T>, FcsMpcMeasure<T>, uint8_t, FcsMpcParams<T>, T> {
+public:
+    static constexpr uint8_t STATES = 8;
+
+    FcsMpc() {};
+
+    /**
+     * @return 0 if ok, -EINVAL else.
+     */
+    int8_t init(FcsMpcParams<T> p) override;
+
+    /**
+     * @brief check the parameters of a FcsMpc
+     *
+     * @return nullptr if ok, the error message else.
+     */
+    static constexpr const char *checkParams(FcsMpcParams<T> p) {
+        if (p.Ts <= 0.0 || p.R <= 0.0 || p.L <= 0.0)
+            return "Ts, R and L must be > 0";
+        if (p.Vdc < 0.0 || p.lambda < 0.0)
+            return "Vdc and lambda must be >= 0";
+        return nullptr;
+    };
+
+    void calculate(void) override;
+
+    void reset(void) override;
+
+    /**
+     * @brief change the dc bus voltage, e.g. from its measure.
+     */
+    void setVdc(T Vdc);
+
+    /**
+     * @brief current predicted for the state chosen by the last `calculate`.
+     */
+    clarke_t<T> getPrediction(void) const {
+        return _prediction;
+    };
+
+    /**
+     * @brief voltage applied by a switching state, in the α, β frame.
+     */
+    clarke_t<T> getVoltage(uint8_t state) const;
+
+private:
+    T _a{};
+    T _b{};
+    T _Vdc{};
+    T _lambda{};
+    bool _delay_compensation{};
+    // b * voltage of each switching state
+    T _bv_alpha[STATES]{};
+    T _bv_beta[STATES]{};
+    clarke_t<T> _prediction{};
+};
+
+} // namespace ot
+
+typedef ot::FcsMpcParams<> FcsMpcParams;
+typedef ot::FcsMpcMeasure<> FcsMpcMeasure;
+typedef ot::FcsMpc<> FcsMpc;
+#endif
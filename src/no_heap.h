@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date 2024
+ * @author Régis Ruelland <regis.ruelland@laas.fr>
+ *
+ * Included last by every source file of the library: with `CONTROL_LIB_NO_HEAP`
+ * any heap allocation in the library is a build error, all the storage comes
+ * from the arena or from the user.
+ */
+#ifndef NO_HEAP_H_
+#define NO_HEAP_H_
+
+#ifdef CONTROL_LIB_NO_HEAP
+#pragma GCC poison malloc calloc realloc new delete
+#endif
+
+#endif
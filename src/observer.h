@@ -0,0 +1,394 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date 2024
+ * @author Régis Ruelland <regis.ruelland@laas.fr>
+ *
+ * Constant gain state observers: steady state Kalman filter and Luenberger.
+ */
+#ifndef OBSERVER_H_
+#define OBSERVER_H_
+#include <errno.h>
+#include <stddef.h>
+#include <array>
+#include <limits>
+#include "controller.h"
+
+namespace ot {
+
+/**
+ * @class ObserverModel
+ * @brief discrete model of the plant and covariances of its noises.
+ *
+ *  x(k+1) = A x(k) + B u(k) + w(k)
+ *  y(k)   = C x(k) + v(k)
+ *
+ * @param Ts sample time
+ *
+ * @param Q covariance of the process noise w (only used by the Kalman gain)
+ *
+ * @param R covariance of the measurement noise v (only used by the Kalman gain)
+ *
+ * @tparam Nx number of states
+ * @tparam Nu number of inputs
+ * @tparam Ny number of measures
+ * @tparam T scalar type
+ */
+template <size_t Nx, size_t Nu, size_t Ny, typename T = ot_scalar_t>
+struct ObserverModel {
+    T Ts;
+    T A[Nx][Nx];
+    T B[Nx][Nu];
+    T C[Ny][Nx];
+    T Q[Nx][Nx];
+    T R[Ny][Ny];
+};
+
+/**
+ * @class ObserverGain
+ * @brief gain of the correction by the measures.
+ */
+template <size_t Nx, size_t Ny, typename T = ot_scalar_t>
+struct ObserverGain {
+    T K[Nx][Ny];
+};
+
+/**
+ * @class Observer
+ * @brief estimates the states of a plant from its inputs and noisy measures,
+ * without the lag of a low pass filter.
+ *
+ * At each sample, with u the input applied during the previous period and y
+ * the new measure:
+ *
+ *  x⁻ = A x + B u
+ *  x  = x⁻ + K (y - C x⁻)
+ *
+ * computed as x = F x + G u + K y with F = (I - K C) A and G = (I - K C) B
+ * prepared by `init`: Nx (Nx + Nu + Ny) products and no inversion by sample.
+ *
+ * The gain is either the steady state Kalman gain, computed from Q and R by
+ * iterating the Riccati equation (`init(model)` or at compile time with
+ * `kalmanGain`), or a gain given by the user (`init(model, gain)`), e.g. a
+ * Luenberger observer designed by pole placement.
+ *
+ * @tparam Nx number of states
+ * @tparam Nu number of inputs
+ * @tparam Ny number of measures
+ * @tparam T scalar type
+ */
+template <size_t Nx, size_t Nu, size_t Ny, typename T = ot_scalar_t>
+class Observer {
+public:
+    typedef std::array<T, Nx> State;
+    typedef std::array<T, Nu> Input;
+    typedef std::array<T, Ny> Measure;
+    typedef ObserverModel<Nx, Nu, Ny, T> Model;
+    typedef ObserverGain<Nx, Ny, T> Gain;
+
+    static constexpr uint16_t MAX_ITERATIONS = 10000;
+
+    constexpr Observer() {};
+
+    /**
+     * @brief initialize the observer with the steady state Kalman gain.
+     *
+     * @return 0 if ok, -EINVAL if the Riccati equation does not converge.
+     */
+    int8_t init(const Model &model) {
+        Gain gain{};
+        const char *error = _riccati(model, gain);
+        if (error != nullptr) {
+            ot_invalid_parameters(error);
+            return -EINVAL;
+        }
+        return init(model, gain);
+    };
+
+    /**
+     * @brief initialize the observer with a given gain, Q and R are not used.
+     *
+     * @return 0 if ok, -EINVAL if Ts <= 0.
+     */
+    int8_t init(const Model &model, const Gain &gain) {
+        if (model.Ts <= 0.0) {
+            ot_invalid_parameters("Ts must be > 0");
+            return -EINVAL;
+        }
+        _gain = gain;
+        // I - K C
+        T IKC[Nx][Nx];
+        for (size_t i = 0; i < Nx; i++) {
+            for (size_t j = 0; j < Nx; j++) {
+                T sum = (i == j) ? 1.0 : 0.0;
+                for (size_t l = 0; l < Ny; l++) {
+                    sum -= gain.K[i][l] * model.C[l][j];
+                }
+                IKC[i][j] = sum;
+            }
+        }
+        for (size_t i = 0; i < Nx; i++) {
+            for (size_t j = 0; j < Nx; j++) {
+                _F[i][j] = 0.0;
+                for (size_t l = 0; l < Nx; l++) {
+                    _F[i][j] += IKC[i][l] * model.A[l][j];
+                }
+            }
+            for (size_t j = 0; j < Nu; j++) {
+                _G[i][j] = 0.0;
+                for (size_t l = 0; l < Nx; l++) {
+                    _G[i][j] += IKC[i][l] * model.B[l][j];
+                }
+            }
+        }
+        reset();
+        return 0;
+    };
+
+    /**
+     * @brief compute the steady state Kalman gain, can be evaluated at compile time.
+     *
+     * Q and R being constant, it is the limit of the gain of the Kalman filter.
+     * A non convergence is a compilation error in a constant expression, at
+     * run time it is logged and the gain is zero.
+     */
+    static constexpr Gain kalmanGain(const Model &model) {
+        Gain gain{};
+        const char *error = _riccati(model, gain);
+        if (error != nullptr) {
+            ot_invalid_parameters(error);
+        }
+        return gain;
+    };
+
+    /**
+     * @brief correct the estimation with a new measure.
+     *
+     * @param u input applied since the previous update
+     * @param y measure
+     * @return estimation of the states at the time of the measure.
+     */
+    const State &update(const Input &u, const Measure &y) {
+        State x;
+        for (size_t i = 0; i < Nx; i++) {
+            T sum = 0.0;
+            for (size_t j = 0; j < Nx; j++) {
+                sum += _F[i][j] * _x[j];
+            }
+            for (size_t j = 0; j < Nu; j++) {
+                sum += _G[i][j] * u[j];
+            }
+            for (size_t j = 0; j < Ny; j++) {
+                sum += _gain.K[i][j] * y[j];
+            }
+            x[i] = sum;
+        }
+        _x = x;
+        return _x;
+    };
+
+    const State &getState(void) const {
+        return _x;
+    };
+
+    /**
+     * @brief set the estimation, e.g. to a known initial state.
+     */
+    void setState(const State &x) {
+        _x = x;
+    };
+
+    const Gain &getGain(void) const {
+        return _gain;
+    };
+
+    void reset(void) {
+        _x = State{};
+    };
+
+private:
+    /**
+     * the Riccati equation is iterated in float64_t whatever T: in float32_t,
+     * the updates of a slowly converging P fall under its rounding and it stops
+     * on a wrong gain. It is only done by `init`.
+     */
+    typedef float64_t Wide;
+
+    /**
+     * relative change of P under which the Riccati iteration has converged: a
+     * few rounding errors of the sums of Nx products.
+     */
+    static constexpr Wide TOLERANCE = 16 * Nx * std::numeric_limits<Wide>::epsilon();
+
+    static constexpr Wide _abs(Wide x) {
+        return x < 0 ? -x : x;
+    };
+
+    /**
+     * @brief inverse of `M` by Gauss-Jordan elimination with partial pivoting.
+     */
+    static constexpr bool _inverse(Wide (&M)[Ny][Ny], Wide (&inverse)[Ny][Ny]) {
+        for (size_t i = 0; i < Ny; i++) {
+            for (size_t j = 0; j < Ny; j++) {
+                inverse[i][j] = (i == j) ? 1.0 : 0.0;
+            }
+        }
+        for (size_t c = 0; c < Ny; c++) {
+            size_t pivot = c;
+            for (size_t i = c + 1; i < Ny; i++) {
+                pivot = _abs(M[i][c]) > _abs(M[pivot][c]) ? i : pivot;
+            }
+            if (_abs(M[pivot][c]) < Wide(1e-30)) {
+                return false;
+            }
+            for (size_t j = 0; j < Ny; j++) {
+                Wide m = M[c][j], v = inverse[c][j];
+                M[c][j] = M[pivot][j];
+                inverse[c][j] = inverse[pivot][j];
+                M[pivot][j] = m;
+                inverse[pivot][j] = v;
+            }
+            Wide scale = 1 / M[c][c];
+            for (size_t j = 0; j < Ny; j++) {
+                M[c][j] *= scale;
+                inverse[c][j] *= scale;
+            }
+            for (size_t i = 0; i < Ny; i++) {
+                Wide factor = M[i][c];
+                if (i == c || factor == 0.0) {
+                    continue;
+                }
+                for (size_t j = 0; j < Ny; j++) {
+                    M[i][j] -= factor * M[c][j];
+                    inverse[i][j] -= factor * inverse[c][j];
+                }
+            }
+        }
+        return true;
+    };
+
+    /**
+     * @brief iterate the Riccati equation of the predicted covariance P:
+     *
+     *  K = P C' (C P C' + R)^-1
+     *  P = A (P - K C P) A' + Q
+     *
+     * @return nullptr if it converges, the error message else, with a zero
+     * gain, when it diverges or has not converged after MAX_ITERATIONS.
+     */
+    static constexpr const char *_riccati(const Model &m, Gain &gain) {
+        if (m.Ts <= 0.0) {
+            return "Ts must be > 0";
+        }
+        gain = Gain{};
+        Wide P[Nx][Nx]{};
+        Wide K[Nx][Ny]{};
+        for (size_t i = 0; i < Nx; i++) {
+            for (size_t j = 0; j < Nx; j++) {
+                P[i][j] = m.Q[i][j];
+            }
+        }
+        for (uint16_t iteration = 0; iteration < MAX_ITERATIONS; iteration++) {
+            // P C' and S = C P C' + R
+            Wide PCt[Nx][Ny]{};
+            for (size_t i = 0; i < Nx; i++) {
+                for (size_t j = 0; j < Ny; j++) {
+                    for (size_t l = 0; l < Nx; l++) {
+                        PCt[i][j] += P[i][l] * m.C[j][l];
+                    }
+                }
+            }
+            Wide S[Ny][Ny]{};
+            for (size_t i = 0; i < Ny; i++) {
+                for (size_t j = 0; j < Ny; j++) {
+                    S[i][j] = m.R[i][j];
+                    for (size_t l = 0; l < Nx; l++) {
+                        S[i][j] += m.C[i][l] * PCt[l][j];
+                    }
+                }
+            }
+            Wide S_inverse[Ny][Ny]{};
+            if (!_inverse(S, S_inverse)) {
+                return "C P C' + R is singular";
+            }
+            for (size_t i = 0; i < Nx; i++) {
+                for (size_t j = 0; j < Ny; j++) {
+                    K[i][j] = 0.0;
+                    for (size_t l = 0; l < Ny; l++) {
+                        K[i][j] += PCt[i][l] * S_inverse[l][j];
+                    }
+                }
+            }
+            // filtered covariance P - K (P C')'
+            Wide Pf[Nx][Nx]{};
+            for (size_t i = 0; i < Nx; i++) {
+                for (size_t j = 0; j < Nx; j++) {
+                    Pf[i][j] = P[i][j];
+                    for (size_t l = 0; l < Ny; l++) {
+                        Pf[i][j] -= K[i][l] * PCt[j][l];
+                    }
+                }
+            }
+            // A Pf A' + Q
+            Wide APf[Nx][Nx]{};
+            for (size_t i = 0; i < Nx; i++) {
+                for (size_t j = 0; j < Nx; j++) {
+                    for (size_t l = 0; l < Nx; l++) {
+                        APf[i][j] += m.A[i][l] * Pf[l][j];
+                    }
+                }
+            }
+            Wide change = 0.0;
+            Wide size = 0.0;
+            for (size_t i = 0; i < Nx; i++) {
+                for (size_t j = 0; j < Nx; j++) {
+                    Wide next = m.Q[i][j];
+                    for (size_t l = 0; l < Nx; l++) {
+                        next += APf[i][l] * m.A[j][l];
+                    }
+                    change = _abs(next - P[i][j]) > change ? _abs(next - P[i][j]) : change;
+                    size = _abs(next) > size ? _abs(next) : size;
+                    P[i][j] = next;
+                }
+            }
+            if (!(size < Wide(1e30))) {
+                break;
+            }
+            if (change <= TOLERANCE * size) {
+                for (size_t i = 0; i < Nx; i++) {
+                    for (size_t j = 0; j < Ny; j++) {
+                        gain.K[i][j] = K[i][j];
+                    }
+                }
+                return nullptr;
+            }
+        }
+        return "the Riccati equation does not converge";
+    };
+
+    T _F[Nx][Nx]{};
+    T _G[Nx][Nu]{};
+    Gain _gain{};
+    State _x{};
+};
+
+} // namespace ot
+
+#endif
@@ -24,102 +24,119 @@
 #include <zephyr/logging/log.h>
 #include <errno.h>
 #include "pid.h"
+#include "no_heap.h"
 
 LOG_MODULE_DECLARE(ot_control);
 
-int8_t Pid::init(PidParams p) {
+namespace ot {
 
-    if (p.Ts <= 0.0) {
-        LOG_ERR("Ts should be > 0");
-        return -EINVAL;
-    }
-    _Ts = p.Ts;
-    _inverse_Ts = 1.0 / p.Ts;
+template <typename T>
+int8_t Pid<T>::init(PidParams<T> p) {
 
-    if (p.Kp == 0.0)
-    {
-        LOG_ERR("Kp equal To 0");
+    const char *error = checkParams(p);
+    if (error != nullptr) {
+        LOG_ERR("%s", error);
         return -EINVAL;
     }
-    _Kp = p.Kp;
-    _inverse_Kp = 1.0 / p.Kp;
+    _setParams(p);
 
-    if ( p.Ti == 0.0 ) {
-        LOG_ERR("Ti can not be equal to 0.0\n");
-        return -EINVAL;
-    } 
-    _Ti = p.Ti;
-    _inverse_Ti = 1.0 / p.Ti;
-
-    _Td = p.Td;
-
-    float32_t tau;
-    if (p.N == 0.0)
-        tau = 0.0;
-    else
-        tau = _Td / p.N;
-    if (tau < 0.0) {
-        LOG_ERR("Td/N should be > 0");
-        return -EINVAL;
-    }
-    _N = p.N;
-    _b1_filter = _Ts / (_Ts + tau );
-    _a1_filter = - tau / (_Ts + tau); 
+    LOG_DBG("_Ts = %f\n", p.Ts);
+    LOG_DBG("_Kp = %f\n", p.Kp);
+    LOG_DBG("_Td = %f\n", p.Td);
+    LOG_DBG("_Ti = %f\n", p.Ti);
+    LOG_DBG("_N = %f\n", p.N);
 
-    if (p.lower_bound > p.upper_bound) {
-        LOG_ERR("lower bound > upper_bound");
+    return 0;
+}
+
+template <typename T>
+int8_t Pid<T>::setParams(PidParams<T> p) {
+    const char *error = checkParams(p);
+    if (error != nullptr) {
+        LOG_ERR("%s", error);
         return -EINVAL;
     }
-    _lower_bound = p.lower_bound;
-    _upper_bound = p.upper_bound;
-
-
-    _integral = 0.0;
-    _previous_error = 0.0;
-    _previous_f_deriv = 0.0;
-    _output = 0.0;
-
-    LOG_DBG("_Ts = %f\n", _Ts);
-    LOG_DBG("_Kp = %f\n", _Kp);
-    LOG_DBG("_Td = %f\n", _Td);
-    LOG_DBG("_Ti = %f\n", _Ti);
-    LOG_DBG("_N = %f\n", _N);
-
+    _coeffs.edit() = _tuning(p);
+    _coeffs.publish();
+    this->_lower_bound = p.lower_bound;
+    this->_upper_bound = p.upper_bound;
     return 0;
 }
 
-void Pid::calculate(void) {
-    float32_t error;
-    float32_t deriv, filtered_deriv;
-    float32_t tmp_output;
-    error = _reference - _measure;
+template <typename T>
+void Pid<T>::setBounds(T lower, T upper) {
+    if (lower < upper) {
+        Tuning &t = _coeffs.edit();
+        t.lower_bound = lower;
+        t.upper_bound = upper;
+        _coeffs.publish();
+        this->_lower_bound = lower;
+        this->_upper_bound = upper;
+    }
+}
 
-    _integral = _integral + _Ts * error;
+template <typename T>
+void Pid<T>::calculate(void) {
+    OT_CYCLES_SCOPE(this->_cycles);
+    T error;
+    T deriv, filtered_deriv;
+    T tmp_output;
+    uint8_t index = _coeffs.acquire();
+    const Tuning &c = _coeffs.get(index);
+    if (index != _index) {
+        // new coefficients: keep the same integral action
+        _integral = _integral * _integral_gain / c.integral_gain;
+        _integral_gain = c.integral_gain;
+        _index = index;
+    }
+    error = this->_reference - this->_measure;
 
-    deriv = _inverse_Ts * (error - _previous_error);
+    _integral = _integral + c.Ts * error;
 
-    filtered_deriv = _b1_filter * deriv - _a1_filter * _previous_f_deriv; 
+    deriv = c.inverse_Ts * (error - _previous_error);
 
-    tmp_output = _Kp * ( error + _inverse_Ti * _integral + _Td * filtered_deriv ) ; 
+    filtered_deriv = c.b1_filter * deriv - c.a1_filter * _previous_f_deriv; 
 
-    _output = saturate(tmp_output);
+    tmp_output = c.Kp * ( error + c.inverse_Ti * _integral + c.Td * filtered_deriv ) ; 
+
+    this->_output = tmp_output;
+    if (this->_output > c.upper_bound) {
+        this->_output = c.upper_bound;
+    }
+    if (this->_output < c.lower_bound) {
+        this->_output = c.lower_bound;
+    }
     // re-compute integral to no have integral divergence during saturation
-    if (_output != tmp_output)
-        _integral = _Ti * (_inverse_Kp * _output - error - _Td * filtered_deriv);
+    if (this->_output != tmp_output)
+        _integral = c.Ti * (c.inverse_Kp * this->_output - error - c.Td * filtered_deriv);
 
     _previous_error = error;
     
     _previous_f_deriv = filtered_deriv;
+    _coeffs.release();
+    OT_RECORD(this->_recorder, {this->_reference, this->_measure, this->_output,
+                                this->_output != tmp_output});
 }
 
 
-void Pid::reset() {
-    Pid::reset(0.0);
+template <typename T>
+void Pid<T>::reset() {
+    Pid<T>::reset(0.0);
 }
 
-void Pid::reset(float32_t output=0.0) {
-    _integral = _Ti * _inverse_Kp * output;
-    _output = 0.0;
+template <typename T>
+void Pid<T>::reset(T output) {
+    _index = _coeffs.acquire();
+    const Tuning &c = _coeffs.get(_index);
+    _integral_gain = c.integral_gain;
+    _integral = c.Ti * c.inverse_Kp * output;
+    this->_output = 0.0;
     _previous_f_deriv = 0.0;
     _previous_error = 0.0;
+    _coeffs.release();
 }
+
+template class Pid<float32_t>;
+template class Pid<float64_t>;
+
+} // namespace ot
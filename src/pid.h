@@ -24,6 +24,9 @@
 #ifndef PID_H_
 #define PID_H_
 #include "controller.h"
+#include "triple_buffer.h"
+
+namespace ot {
 
 /**
  * @class PidParams
@@ -43,15 +46,17 @@
  *
  * @param upper_bound max value of the output
  *
+ * @tparam T scalar type
  */
+template <typename T = ot_scalar_t>
 struct PidParams {
-    float32_t Ts;
-    float32_t Kp;
-    float32_t Ti;
-    float32_t Td;
-    float32_t N;
-    float32_t lower_bound;
-    float32_t upper_bound;
+    T Ts;
+    T Kp;
+    T Ti;
+    T Td;
+    T N;
+    T lower_bound;
+    T upper_bound;
 };
 
 
@@ -73,12 +78,39 @@ struct PidParams {
  *  mypid.setReference(yref);
  *  mypid.calculate();
  *  mypid.getOutput();
+ *
+ *  With parameters known at compile time, the coefficients can be computed by
+ *  the compiler and the Pid stored initialized:
+ *
+ *  constinit Pid mypid(PidParams(Ts, Kp, Ti, Td, N, lower_bound, upper_bound));
+ *
+ *  It can be retuned with `setParams` or `setBounds` from a thread while
+ *  `calculate` runs in an interrupt: the coefficients are triple buffered and
+ *  the integral action is kept continuous (bumpless).
  *  
  */
-class Pid: public Controller <float32_t, float32_t, float32_t, PidParams> {
+template <typename T = ot_scalar_t>
+class Pid: public Controller <T, T, T, PidParams<T>, T> {
 
 public:
-    Pid(){};
+    constexpr Pid(){};
+
+    /**
+     * @brief build an initialized standard pid, can be evaluated at compile time.
+     *
+     * Invalid parameters are a compilation error in a constant expression and
+     * are logged at run time.
+     *
+     * @param params is a PidParams structure with all the parameters of the Pid.
+     */
+    constexpr Pid(PidParams<T> params) {
+        const char *error = checkParams(params);
+        if (error != nullptr) {
+            ot_invalid_parameters(error);
+            return;
+        }
+        _setParams(params);
+    };
 
     /**
      * @brief initialize the standard pid
@@ -86,27 +118,132 @@ public:
      * @param params is a PidParams structure with all the parameters of the Pid.
      * @return 0 if ok else -EINVAL
      */
-    int8_t init(PidParams params) override; 
+    int8_t init(PidParams<T> params) override; 
+
+    /**
+     * @brief check the parameters of a Pid
+     *
+     * @return nullptr if ok, the error message else.
+     */
+    static constexpr const char *checkParams(PidParams<T> p) {
+        if (p.Ts <= 0.0) 
+            return "Ts should be > 0";
+        if (p.Kp == 0.0)
+            return "Kp equal To 0";
+        if (p.Ti == 0.0)
+            return "Ti can not be equal to 0.0";
+        if (p.N != 0.0 && p.Td / p.N < 0.0)
+            return "Td/N should be > 0";
+        if (p.lower_bound > p.upper_bound)
+            return "lower bound > upper_bound";
+        return nullptr;
+    };
+
+    /**
+     * @brief change the parameters without resetting the states.
+     *
+     * It can be called from a thread while `calculate` runs in an interrupt:
+     * the new coefficients are used as a whole by the next `calculate`.
+     *
+     * @return 0 if ok else -EINVAL
+     */
+    int8_t setParams(PidParams<T> params);
+
+    /**
+     * @brief change the output bounds, like `setParams`.
+     */
+    void setBounds(T lower, T upper) override;
 
     void calculate(void) override;
 
     void reset() override;
 
-    void reset(float32_t output);
+    void reset(T output);
+
+    /**
+     * @brief internal signals, e.g. to capture them with a `Scope`.
+     */
+    const T &getIntegral(void) const {
+        return _integral;
+    };
+
+    const T &getFilteredDerivative(void) const {
+        return _previous_f_deriv;
+    };
 
 private:
-    float32_t _integral;
-    float32_t _Kp;
-    float32_t _Ti;
-    float32_t _Td;
-    float32_t _N;
-    float32_t _previous_f_deriv; // previous filtered derivative value
-    float32_t _previous_error;  // previous error
-
-    float32_t _inverse_Ts;
-    float32_t _inverse_Ti;
-    float32_t _inverse_Kp;
-    float32_t _b1_filter;
-    float32_t _a1_filter;
+    /**
+     * @brief coefficients computed from the parameters.
+     */
+    struct Tuning {
+        T Ts;
+        T Kp;
+        T Ti;
+        T Td;
+        T N;
+        T inverse_Ts;
+        T inverse_Ti;
+        T inverse_Kp;
+        T b1_filter;
+        T a1_filter;
+        T integral_gain; // Kp / Ti
+        T lower_bound;
+        T upper_bound;
+    };
+
+    static constexpr Tuning _tuning(PidParams<T> p) {
+        Tuning t{};
+        t.Ts = p.Ts;
+        t.inverse_Ts = 1.0 / p.Ts;
+        t.Kp = p.Kp;
+        t.inverse_Kp = 1.0 / p.Kp;
+        t.Ti = p.Ti;
+        t.inverse_Ti = 1.0 / p.Ti;
+        t.Td = p.Td;
+
+        T tau;
+        if (p.N == 0.0)
+            tau = 0.0;
+        else
+            tau = t.Td / p.N;
+        t.N = p.N;
+        t.b1_filter = t.Ts / (t.Ts + tau );
+        t.a1_filter = - tau / (t.Ts + tau); 
+        t.integral_gain = t.Kp * t.inverse_Ti;
+
+        t.lower_bound = p.lower_bound;
+        t.upper_bound = p.upper_bound;
+        return t;
+    };
+
+    /**
+     * @brief compute the coefficients from valid parameters and reset the states.
+     */
+    constexpr void _setParams(PidParams<T> p) {
+        _coeffs.init(_tuning(p));
+        _index = _coeffs.activeIndex();
+        _integral_gain = _coeffs.active().integral_gain;
+        this->_Ts = p.Ts;
+        this->_lower_bound = p.lower_bound;
+        this->_upper_bound = p.upper_bound;
+
+        _integral = 0.0;
+        _previous_error = 0.0;
+        _previous_f_deriv = 0.0;
+        this->_output = 0.0;
+    };
+
+    TripleBuffer<Tuning> _coeffs;
+    uint8_t _index{}; // index of the coefficients used by the last calculate
+    T _integral_gain{}; // Kp / Ti used by the last calculate
+
+    T _integral{};
+    T _previous_f_deriv{}; // previous filtered derivative value
+    T _previous_error{};  // previous error
 };
+
+} // namespace ot
+
+typedef ot::PidParams<> PidParams;
+typedef ot::Pid<> Pid;
 #endif
@@ -26,65 +26,110 @@
 #include <zephyr/logging/log.h>
 #include "trigo.h"
 #include "pr.h"
+#include "no_heap.h"
 
 LOG_MODULE_DECLARE(ot_control);
 
-int8_t Pr::init(PrParams p) {
+namespace ot {
 
-    _Ts = p.Ts;
-    _Kp = p.Kp;
-    if (p.Kr == 0.0) {
-        LOG_ERR("Kr = 0 is not possible");
-        return -EINVAL; 
-    }
-    _Kr = p.Kr;
-    _inverse_Kr = 1.0 / p.Kr;
-
-    _w0 = p.w0;
-    _phi_prime = p.phi_prime;
-
-    float b[2];
-    b[0] = p.Ts * ot_cos(p.phi_prime);
-    b[1] = -p.Ts * ot_cos(p.phi_prime - p.w0 * p.Ts);
-
-    _B.init(2, b);
+template <typename T>
+int8_t Pr<T>::init(PrParams<T> p) {
+    PrCoefficients<T> c;
+    c.b[0] = p.Ts * ot_cos(p.phi_prime);
+    c.b[1] = -p.Ts * ot_cos(p.phi_prime - p.w0 * p.Ts);
+    c.a[0] = - 2 * ot_cos(p.Ts * p.w0);
+    c.a[1] = +1.0;
+    return init(p, c);
+}
 
-    float a[2];
-    a[0] = - 2 * ot_cos(p.Ts * p.w0);
-    a[1] = +1.0;
-    _A.init(2, a);
+template <typename T>
+int8_t Pr<T>::init(PrParams<T> p, const PrCoefficients<T> &c) {
 
-    if (p.upper_bound < p.lower_bound) {
-        LOG_ERR("bounds are not correct\n");
-        return -EINVAL;
+    const char *error = checkParams(p);
+    if (error != nullptr) {
+        LOG_ERR("%s", error);
+        return -EINVAL; 
     }
-    _lower_bound = p.lower_bound;
-    _upper_bound = p.upper_bound;
-    
-    _output = 0.0;
-    _resonant = 0.0;
+    _setParams(p, c);
     return 0;
 }
 
-void Pr::calculate(void) {
-    float32_t error = _reference - _measure;
-    _resonant = _B.update(error) - _A.update(_resonant);
-    float32_t tmp_output = _Kp * error + _Kr * _resonant;
+template <typename T>
+void Pr<T>::calculate(void) {
+    OT_CYCLES_SCOPE(this->_cycles);
+    const Tuning &t = _tuning.get(_tuning.acquire());
+    T error = this->_reference - this->_measure;
+    T resonant = (t.c.b[0] * error + t.c.b[1] * _previous_error)
+               - (t.c.a[0] * _resonant + t.c.a[1] * _previous_resonant);
+    _previous_error = error;
+    _previous_resonant = _resonant;
+    T tmp_output = t.p.Kp * error + t.p.Kr * resonant;
     // saturation management ?
-    _output = saturate(tmp_output);
-    if (tmp_output != _output)
-        _resonant = _inverse_Kr * (_output - _Kp * error); 
+    this->_output = tmp_output;
+    if (this->_output > t.p.upper_bound) {
+        this->_output = t.p.upper_bound;
+    }
+    if (this->_output < t.p.lower_bound) {
+        this->_output = t.p.lower_bound;
+    }
+    if (tmp_output != this->_output)
+        resonant = t.inverse_Kr * (this->_output - t.p.Kp * error); 
+    _resonant = resonant;
+    _tuning.release();
+    OT_RECORD(this->_recorder, {this->_reference, this->_measure, this->_output,
+                                this->_output != tmp_output});
 }
 
-void Pr::reset(void) {
-    _A.reset();
-    _B.reset();
+template <typename T>
+void Pr<T>::reset(void) {
+    _previous_error = 0.0;
     _resonant = 0.0;
-    _output = 0.0;
+    _previous_resonant = 0.0;
+    this->_output = 0.0;
 }
 
-void Pr::setW0(float32_t value) {
-    _w0 = value;
-   _B.setCoeff(1, -_Ts * ot_cos(_phi_prime - _w0 * _Ts ));
-   _A.setCoeff(0, -2 * ot_cos(_Ts * _w0));
+template <typename T>
+void Pr<T>::setW0(T value) {
+    Tuning &t = _tuning.edit();
+    t.p.w0 = value;
+    t.c.b[1] = -t.p.Ts * ot_cos(t.p.phi_prime - value * t.p.Ts);
+    t.c.a[0] = -2 * ot_cos(t.p.Ts * value);
+    _tuning.publish();
 }
+
+template <typename T>
+int8_t Pr<T>::setParams(PrParams<T> p) {
+    const char *error = checkParams(p);
+    if (error != nullptr) {
+        LOG_ERR("%s", error);
+        return -EINVAL; 
+    }
+    Tuning &t = _tuning.edit();
+    t.p = p;
+    t.c.b[0] = p.Ts * ot_cos(p.phi_prime);
+    t.c.b[1] = -p.Ts * ot_cos(p.phi_prime - p.w0 * p.Ts);
+    t.c.a[0] = - 2 * ot_cos(p.Ts * p.w0);
+    t.c.a[1] = +1.0;
+    t.inverse_Kr = 1.0 / p.Kr;
+    _tuning.publish();
+    this->_lower_bound = p.lower_bound;
+    this->_upper_bound = p.upper_bound;
+    return 0;
+}
+
+template <typename T>
+void Pr<T>::setBounds(T lower, T upper) {
+    if (lower < upper) {
+        Tuning &t = _tuning.edit();
+        t.p.lower_bound = lower;
+        t.p.upper_bound = upper;
+        _tuning.publish();
+        this->_lower_bound = lower;
+        this->_upper_bound = upper;
+    }
+}
+
+template class Pr<float32_t>;
+template class Pr<float64_t>;
+
+} // namespace ot
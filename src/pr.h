@@ -24,8 +24,13 @@
  *
  */
 
+#ifndef PR_H_
+#define PR_H_
 #include "controller.h"
-#include "fir.h"
+#include "triple_buffer.h"
+#include "trigo.h"
+
+namespace ot {
 
 /**
  * @class PrParams
@@ -45,39 +50,118 @@
  *
  * @param upper_bound max value of the output
  *
+ * @tparam T scalar type
  */
+template <typename T = ot_scalar_t>
 struct PrParams {
-    float32_t Ts;
-    float32_t Kp;
-    float32_t Kr;
-    float32_t w0;
-    float32_t phi_prime;
-    float32_t lower_bound;
-    float32_t upper_bound;
+    T Ts;
+    T Kp;
+    T Kr;
+    T w0;
+    T phi_prime;
+    T lower_bound;
+    T upper_bound;
 };
 
-class Pr: public Controller <float32_t, float32_t, float32_t, PrParams> {
+/**
+ * @class PrCoefficients
+ * @brief coefficients of the resonator of a Pr.
+ *
+ * @param b numerator
+ *
+ * @param a denominator (without the leading 1)
+ *
+ * @tparam T scalar type
+ */
+template <typename T = ot_scalar_t>
+struct PrCoefficients {
+    T b[2];
+    T a[2];
+};
+
+/**
+ * @class Pr
+ * @brief Proportional Resonant controller.
+ *
+ * When the parameters are known at compile time, the resonator coefficients can
+ * be computed by the compiler to avoid any trigonometric call at run time:
+ *
+ *  constexpr PrParams params(Ts, Kp, Kr, w0, phi_prime, lower_bound, upper_bound);
+ *  constexpr PrCoefficients coeffs = Pr::coefficients(params);
+ *  mypr.init(params, coeffs);
+ *
+ * or the whole controller can be built by the compiler:
+ *
+ *  constinit Pr mypr(PrParams(Ts, Kp, Kr, w0, phi_prime, lower_bound, upper_bound));
+ *
+ * It can be retuned with `setW0`, `setParams` or `setBounds` from a thread while
+ * `calculate` runs in an interrupt: the coefficients are triple buffered and the
+ * resonator states are kept.
+ */
+template <typename T = ot_scalar_t>
+class Pr: public Controller <T, T, T, PrParams<T>, T> {
 
 public:
-    Pr() {};
+    constexpr Pr() {};
 
-    int8_t init(PrParams p);
+    /**
+     * @brief build an initialized controller, can be evaluated at compile time.
+     *
+     * Invalid parameters are a compilation error in a constant expression.
+     */
+    constexpr Pr(PrParams<T> p) {
+        _setParams(p, coefficients(p));
+    };
+
+    int8_t init(PrParams<T> p);
 
     /**
-     * @brief calculate a new command value according to a reference fixed using
-     * `set_reference` method and a measuremnt fixed using `set_measurement`.
+     * @brief initialize the controller with precomputed resonator coefficients.
      *
-     * The new command value can be captured using the `get_output` method.
+     * @param p parameters
+     * @param c coefficients given by `coefficients(p)`
+     * @return 0 if ok, -EINVAL else.
      */
-    void calculate(void);
+    int8_t init(PrParams<T> p, const PrCoefficients<T> &c);
 
     /**
-     * @brief calculate a new command value according the argument values
+     * @brief check the parameters of a Pr
      *
-     * @param yrefs reference
-     * @param y measure
-     * @return new command value.
+     * @return nullptr if ok, the error message else.
      */
+    static constexpr const char *checkParams(PrParams<T> p) {
+        if (p.Kr == 0.0)
+            return "Kr = 0 is not possible";
+        if (p.upper_bound < p.lower_bound)
+            return "bounds are not correct";
+        return nullptr;
+    };
+
+    /**
+     * @brief compute the resonator coefficients, can be evaluated at compile time.
+     *
+     * Invalid parameters are a compilation error in a constant expression.
+     */
+    static constexpr PrCoefficients<T> coefficients(PrParams<T> p) {
+        const char *error = checkParams(p);
+        if (error != nullptr) {
+            ot_invalid_parameters(error);
+        }
+        PrCoefficients<T> c;
+        c.b[0] = p.Ts * ot_constexpr_cos(p.phi_prime);
+        c.b[1] = -p.Ts * ot_constexpr_cos(p.phi_prime - p.w0 * p.Ts);
+        c.a[0] = - 2 * ot_constexpr_cos(p.Ts * p.w0);
+        c.a[1] = +1.0;
+        return c;
+    };
+
+    /**
+     * @brief calculate a new command value according to a reference fixed using
+     * `set_reference` method and a measuremnt fixed using `set_measurement`.
+     *
+     * The new command value can be captured using the `get_output` method.
+     */
+    void calculate(void);
 
     void reset(void);
 
@@ -86,16 +170,57 @@ public:
      * 
      * @param w0 pulsation in [rad/s]
      */
-    void setW0(float value);
+    void setW0(T value);
+
+    /**
+     * @brief change the parameters without resetting the resonator states.
+     *
+     * @return 0 if ok, -EINVAL else.
+     */
+    int8_t setParams(PrParams<T> p);
+
+    /**
+     * @brief change the output bounds without resetting the states.
+     */
+    void setBounds(T lower, T upper) override;
+
+    /**
+     * @brief output of the resonator, e.g. to capture it with a `Scope`.
+     */
+    const T &getResonant(void) const {
+        return _resonant;
+    };
 
 private:
-    float32_t _Ts;
-    float32_t _Kp;
-    float32_t _Kr;
-    float32_t _inverse_Kr;
-    float32_t _w0;
-    float32_t _phi_prime;
-    Fir _B; // numerator of the resonator
-    Fir _A; // denominator of the resonator
-    float32_t _resonant; // resonator output
+    /**
+     * @brief parameters and the coefficients computed from them.
+     */
+    struct Tuning {
+        PrParams<T> p;
+        PrCoefficients<T> c;
+        T inverse_Kr;
+    };
+
+    constexpr void _setParams(PrParams<T> p, const PrCoefficients<T> &c) {
+        _tuning.init(Tuning(p, c, 1.0 / p.Kr));
+        this->_Ts = p.Ts;
+        this->_lower_bound = p.lower_bound;
+        this->_upper_bound = p.upper_bound;
+        this->_output = 0.0;
+        _previous_error = 0.0;
+        _resonant = 0.0;
+        _previous_resonant = 0.0;
+    };
+
+    TripleBuffer<Tuning> _tuning;
+    T _previous_error{};
+    T _resonant{}; // resonator output
+    T _previous_resonant{};
 };
+
+} // namespace ot
+
+typedef ot::PrParams<> PrParams;
+typedef ot::PrCoefficients<> PrCoefficients;
+typedef ot::Pr<> Pr;
+#endif
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date 2024
+ * @author Régis Ruelland <regis.ruelland@laas.fr>
+ *
+ * Recording of the inputs and outputs of the controllers, filters and plls.
+ *
+ * When `CONTROL_LIB_RECORDER` is defined, each of them can be given a
+ * `Recorder` with `setRecorder()`: every calculation appends a `RecordSample`
+ * to it. The recorder is a lock-free ring buffer with one writer (the control
+ * interrupt) and one reader (a thread draining it to a file or an uart), a
+ * sample being dropped when it is full. Without the define `OT_RECORD`
+ * expands to nothing.
+ *
+ * The samples of the filters have the input signal as `reference`, and 0 as
+ * `measure`; those of the plls have the signal as `reference`, the new angle
+ * as `measure` and the pulsation as `output`.
+ */
+#ifndef RECORDER_H_
+#define RECORDER_H_
+#include <errno.h>
+#include <stdint.h>
+#include <atomic>
+#include "scalar.h"
+
+namespace ot {
+
+/**
+ * @brief one calculation: its inputs, its output and if it has been saturated.
+ */
+template <typename refs_T = ot_scalar_t, typename meas_T = refs_T, typename outputs_T = refs_T>
+struct RecordSample {
+    refs_T reference;
+    meas_T measure;
+    outputs_T output;
+    uint8_t saturated;
+};
+
+/**
+ * @class Recorder
+ * @brief single producer, single consumer ring buffer of samples.
+ *
+ * The memory is given by the application with `init`, its number of samples
+ * must be a power of 2.
+ *
+ * @tparam S type of the samples
+ */
+template <typename S>
+class Recorder {
+public:
+    constexpr Recorder() {};
+
+    /**
+     * @return 0 if ok, -EINVAL if `size` is not a power of 2.
+     */
+    int8_t init(S *buffer, uint32_t size) {
+        if (buffer == nullptr || size == 0 || (size & (size - 1)) != 0) {
+            return -EINVAL;
+        }
+        _buffer = buffer;
+        _mask = size - 1;
+        _head = 0;
+        _tail = 0;
+        _dropped = 0;
+        return 0;
+    };
+
+    /**
+     * @brief writer side: append a sample, it never waits.
+     *
+     * @return false if the buffer is full and the sample is dropped.
+     */
+    inline bool push(const S &sample) {
+        uint32_t head = _head;
+        if (head - std::atomic_ref<uint32_t>(_tail).load(std::memory_order_acquire) > _mask) {
+            std::atomic_ref<uint32_t>(_dropped).store(_dropped + 1, std::memory_order_relaxed);
+            return false;
+        }
+        _buffer[head & _mask] = sample;
+        std::atomic_ref<uint32_t>(_head).store(head + 1, std::memory_order_release);
+        return true;
+    };
+
+    /**
+     * @brief reader side: give the samples recorded since the last call.
+     *
+     * @param sink called with contiguous blocks of samples (`sink(const S *samples,
+     * uint32_t count)`), e.g. to write them to a file or an uart.
+     * @return the number of samples given.
+     */
+    template <typename F>
+    uint32_t drain(F &&sink) {
+        uint32_t head = std::atomic_ref<uint32_t>(_head).load(std::memory_order_acquire);
+        uint32_t tail = _tail;
+        uint32_t count = head - tail;
+        while (tail != head) {
+            uint32_t index = tail & _mask;
+            uint32_t block = _mask + 1 - index;
+            if (block > head - tail) {
+                block = head - tail;
+            }
+            sink(_buffer + index, block);
+            tail += block;
+            std::atomic_ref<uint32_t>(_tail).store(tail, std::memory_order_release);
+        }
+        return count;
+    };
+
+    /**
+     * @brief number of samples dropped because the buffer was full.
+     */
+    uint32_t getDropped(void) {
+        return std::atomic_ref<uint32_t>(_dropped).load(std::memory_order_relaxed);
+    };
+
+private:
+    S *_buffer = nullptr;
+    uint32_t _mask = 0;
+    alignas(std::atomic_ref<uint32_t>::required_alignment) uint32_t _head = 0;
+    alignas(std::atomic_ref<uint32_t>::required_alignment) uint32_t _tail = 0;
+    alignas(std::atomic_ref<uint32_t>::required_alignment) uint32_t _dropped = 0;
+};
+
+} // namespace ot
+
+#ifdef CONTROL_LIB_RECORDER
+#define OT_RECORD(recorder, ...) do { \
+        if ((recorder) != nullptr) { \
+            (recorder)->push(__VA_ARGS__); \
+        } \
+    } while (0)
+#else
+#define OT_RECORD(recorder, ...)
+#endif
+
+#endif
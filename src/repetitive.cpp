@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date 2024
+ * @author Régis Ruelland <regis.ruelland@laas.fr>
+ */
+#include <errno.h>
+#include <math.h>
+#include <zephyr/logging/log.h>
+#include "trigo.h"
+#include "repetitive.h"
+#include "no_heap.h"
+
+LOG_MODULE_DECLARE(ot_control);
+
+namespace ot {
+
+template <typename T>
+const char *Repetitive<T>::_tune(RepetitiveParams<T> p, Tuning &t) {
+    if (p.Ts <= 0.0 || p.w0 <= 0.0)
+        return "Ts and w0 must be > 0";
+    T period = 2 * ot_pi<T> / (p.w0 * p.Ts);
+    if (period - p.lead < 1.0 || period < 2.0)
+        return "the period is too short for the lead";
+    // delay of the tap of Q nearest to k
+    T delay = period - 1;
+    uint16_t n = static_cast<uint16_t>(floor(delay));
+    if (n + 3 >= p.capacity)
+        return "the period does not fit in the buffer";
+    T f = delay - n;
+    t.p = p;
+    t.period_delay = n;
+    // linear interpolation of the three taps of Q
+    t.weights[0] = p.q * (1 - f);
+    t.weights[1] = p.q * f + (1 - 2 * p.q) * (1 - f);
+    t.weights[2] = (1 - 2 * p.q) * f + p.q * (1 - f);
+    t.weights[3] = p.q * f;
+    delay = period - p.lead;
+    t.output_delay = static_cast<uint16_t>(floor(delay));
+    t.output_fraction = delay - t.output_delay;
+    return nullptr;
+}
+
+template <typename T>
+const char *Repetitive<T>::checkParams(RepetitiveParams<T> p) {
+    if (p.buffer == nullptr)
+        return "nullptr on buffer";
+    if (p.Kr <= 0.0 || p.Kr >= 2.0)
+        return "Kr must be in ]0, 2[";
+    if (p.q < 0.0 || p.q > 0.25)
+        return "q must be in [0, 0.25]";
+    if (p.upper_bound < p.lower_bound)
+        return "bounds are not correct";
+    Tuning t;
+    return _tune(p, t);
+}
+
+template <typename T>
+int8_t Repetitive<T>::init(RepetitiveParams<T> p) {
+    const char *error = checkParams(p);
+    if (error != nullptr) {
+        LOG_ERR("%s", error);
+        return -EINVAL;
+    }
+    Tuning t;
+    _tune(p, t);
+    _tuning.init(t);
+    this->_Ts = p.Ts;
+    this->_lower_bound = p.lower_bound;
+    this->_upper_bound = p.upper_bound;
+    _buffer = p.buffer;
+    _capacity = p.capacity;
+    reset();
+    return 0;
+}
+
+template <typename T>
+void Repetitive<T>::calculate(void) {
+    OT_CYCLES_SCOPE(this->_cycles);
+    const Tuning &t = _tuning.get(_tuning.acquire());
+    T error = this->_reference - this->_measure;
+    uint16_t index = _index(t.output_delay);
+    uint16_t next = index == 0 ? _capacity - 1 : index - 1;
+    T repetitive = (1 - t.output_fraction) * _buffer[index] + t.output_fraction * _buffer[next];
+
+    T learned = t.p.Kr * error;
+    index = _index(t.period_delay);
+    for (uint8_t j = 0; j < 4; j++) {
+        learned += t.weights[j] * _buffer[index];
+        index = index == 0 ? _capacity - 1 : index - 1;
+    }
+    learned = learned > t.p.upper_bound ? t.p.upper_bound : learned;
+    learned = learned < t.p.lower_bound ? t.p.lower_bound : learned;
+    _buffer[_position] = learned;
+    _position = _position + 1 == _capacity ? 0 : _position + 1;
+
+    T tmp_output = t.p.Kp * error + repetitive;
+    this->_output = tmp_output;
+    if (this->_output > t.p.upper_bound) {
+        this->_output = t.p.upper_bound;
+    }
+    if (this->_output < t.p.lower_bound) {
+        this->_output = t.p.lower_bound;
+    }
+    _repetitive = repetitive;
+    _tuning.release();
+    OT_RECORD(this->_recorder, {this->_reference, this->_measure, this->_output,
+                                this->_output != tmp_output});
+}
+
+template <typename T>
+void Repetitive<T>::reset(void) {
+    for (uint16_t k = 0; k < _capacity; k++) {
+        _buffer[k] = 0.0;
+    }
+    _position = 0;
+    _repetitive = 0.0;
+    this->_output = 0.0;
+}
+
+template <typename T>
+int8_t Repetitive<T>::setW0(T w0) {
+    Tuning &t = _tuning.edit();
+    RepetitiveParams<T> p = t.p;
+    p.w0 = w0;
+    const char *error = _tune(p, t);
+    if (error != nullptr) {
+        LOG_ERR("%s", error);
+        return -EINVAL;
+    }
+    _tuning.publish();
+    return 0;
+}
+
+template <typename T>
+void Repetitive<T>::setBounds(T lower, T upper) {
+    if (lower < upper) {
+        Tuning &t = _tuning.edit();
+        t.p.lower_bound = lower;
+        t.p.upper_bound = upper;
+        _tuning.publish();
+        this->_lower_bound = lower;
+        this->_upper_bound = upper;
+    }
+}
+
+template class Repetitive<float32_t>;
+template class Repetitive<float64_t>;
+
+} // namespace ot
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date 2024
+ * @author Régis Ruelland <regis.ruelland@laas.fr>
+ */
+#ifndef REPETITIVE_H_
+#define REPETITIVE_H_
+#include "controller.h"
+#include "triple_buffer.h"
+
+namespace ot {
+
+/**
+ * @class RepetitiveParams
+ * @brief parameters of the repetitive controller.
+ *
+ * @param Ts sample time
+ *
+ * @param Kp proportional gain
+ *
+ * @param Kr repetitive gain, in ]0, 2[ for a stable learning, usually 0.1 to 1
+ *
+ * @param w0 fundamental pulsation [rad/s], the period is 2π / (w0 Ts) samples
+ *
+ * @param q side coefficient of the Q filter [q, 1 - 2q, q], in [0, 0.25]: it
+ * lowers the gain at high harmonics for robustness, 0 to disable it
+ *
+ * @param lead phase lead in samples to compensate the delays of the plant
+ *
+ * @param lower_bound min value of the output
+ *
+ * @param upper_bound max value of the output
+ *
+ * @param buffer memory of the period buffer, e.g. a static array
+ *
+ * @param capacity number of elements of `buffer`, at least the period + 3
+ *
+ * @tparam T scalar type
+ */
+template <typename T = ot_scalar_t>
+struct RepetitiveParams {
+    T Ts;
+    T Kp;
+    T Kr;
+    T w0;
+    T q;
+    uint16_t lead;
+    T lower_bound;
+    T upper_bound;
+    T *buffer;
+    uint16_t capacity;
+};
+
+/**
+ * @class Repetitive
+ * @brief repetitive controller rejecting a periodic disturbance with all its
+ * harmonics.
+ *
+ * The learned signal v is stored in a circular buffer of one period N:
+ *
+ *  v(k)   = Q(v)(k - N) + Kr e(k)
+ *  u_r(k) = v(k - N + lead)
+ *
+ * so that u_r(k) = Q(u_r)(k - N) + Kr e(k - N + lead), Q being the zero phase
+ * filter [q, 1 - 2q, q]. The period N is fractional (linear interpolation): 6
+ * products by sample whatever the number of harmonics. The output is
+ * Kp e + u_r, saturated; v is kept between the bounds of the output so that
+ * it does not wind up.
+ *
+ * The pulsation can follow the grid with `setW0`, e.g. with the `w` of a
+ * `PllSinus`, while `calculate` runs: the interpolation coefficients are
+ * triple buffered. The buffer is given by the user, usually static:
+ *
+ *  static float32_t period[512];
+ *  repetitive.init(RepetitiveParams(Ts, Kp, Kr, w0, q, lead, lower, upper, period, 512));
+ */
+template <typename T = ot_scalar_t>
+class Repetitive: public Controller<T, T, T, RepetitiveParams<T>, T> {
+public:
+    Repetitive() {};
+
+    /**
+     * @return 0 if ok, -EINVAL else.
+     */
+    int8_t init(RepetitiveParams<T> p) override;
+
+    /**
+     * @brief check the parameters of a Repetitive controller
+     *
+     * @return nullptr if ok, the error message else.
+     */
+    static const char *checkParams(RepetitiveParams<T> p);
+
+    void calculate(void) override;
+
+    void reset(void) override;
+
+    /**
+     * @brief change the fundamental pulsation, keeping the learned signal.
+     *
+     * @param w0 pulsation [rad/s]
+     * @return 0 if ok, -EINVAL if the period does not fit in the buffer.
+     */
+    int8_t setW0(T w0);
+
+    /**
+     * @brief change the output bounds without forgetting the learned signal.
+     */
+    void setBounds(T lower, T upper) override;
+
+    /**
+     * @brief last output of the repetitive part, e.g. to capture it with a `Scope`.
+     */
+    const T &getRepetitive(void) const {
+        return _repetitive;
+    };
+
+private:
+    /**
+     * @brief parameters and the interpolation of the delayed samples:
+     * - Q(v)(k - N) is the sum of `weights[j]` times v delayed by `period_delay + j`,
+     * - u_r is v delayed by `output_delay` and by `output_delay + 1`, weighted by
+     *   1 - `output_fraction` and `output_fraction`.
+     */
+    struct Tuning {
+        RepetitiveParams<T> p;
+        uint16_t period_delay;
+        T weights[4];
+        uint16_t output_delay;
+        T output_fraction;
+    };
+
+    /**
+     * @return index in the buffer of v(k - delay).
+     */
+    uint16_t _index(uint16_t delay) const {
+        return _position >= delay ? _position - delay : _position + _capacity - delay;
+    };
+
+    static const char *_tune(RepetitiveParams<T> p, Tuning &t);
+
+    TripleBuffer<Tuning> _tuning;
+    T *_buffer{};
+    uint16_t _capacity{};
+    uint16_t _position{}; // where s(k) is written
+    T _repetitive{};
+};
+
+} // namespace ot
+
+typedef ot::RepetitiveParams<> RepetitiveParams;
+typedef ot::Repetitive<> Repetitive;
+#endif
@@ -24,11 +24,15 @@
 #include <errno.h>
 #include <zephyr/logging/log.h> 
 #include "rst.h"
+#include "no_heap.h"
 //TODO: make desctructor atleast for test maybe ?
 LOG_MODULE_DECLARE(ot_control);
 
 
-int8_t RST::init(RstParams p) {
+namespace ot {
+
+template <typename T>
+int8_t RST<T>::init(RstParams<T> p) {
 
     if(p.lower_bound > p.upper_bound) {
         LOG_ERR("lower_bound > upper_bound");
@@ -38,6 +42,11 @@ int8_t RST::init(RstParams p) {
     this->_lower_bound = p.lower_bound;
     this->_upper_bound = p.upper_bound;
 
+    if (p.r == nullptr || p.s == nullptr || p.t == nullptr) {
+        LOG_ERR("nullptr on r, s or t");
+        return -EINVAL;
+    }
+
     if (p.s[0] < 1e-6) { // TODO s0 can be negative ?
         LOG_ERR("s0 too low");
         return -EINVAL;
@@ -49,31 +58,36 @@ int8_t RST::init(RstParams p) {
         return -EINVAL;
     }
 
-    if (p.r == nullptr || p.s == nullptr || p.t == nullptr) {
-        LOG_ERR("nullptr on r, s or t");
-        return -EINVAL;
+    int8_t ret = _R.init(p.nr, p.r);
+    if (ret == 0) {
+        ret = _T.init(p.nt, p.t);
+    }
+    if (ret == 0) {
+        ret = _Sp.init(p.ns-1, &p.s[1]);  // remove first coeff
     }
-    
-    _R.init(p.nr, p.r);
-    _T.init(p.nt, p.t); 
-    _Sp.init(p.ns-1, &p.s[1]);  // remove first coeff
-    
-    return 0;
+    return ret;
 }
 
-void RST::calculate(void) {
-    float32_t new_u = 0.0;
+template <typename T>
+void RST<T>::calculate(void) {
+    OT_CYCLES_SCOPE(this->_cycles);
+    T new_u = 0.0;
     // TODO: integrate inv_s0 in all coeffs ?
-    new_u = _inv_s0 * (_T.update(_reference) - _R.update(_measure) - _Sp.update(_output));
-    new_u = saturate(new_u);
-    _output = new_u;
+    new_u = _inv_s0 * (_T.update(this->_reference) - _R.update(this->_measure) - _Sp.update(this->_output));
+    this->_output = this->saturate(new_u);
+    OT_RECORD(this->_recorder, {this->_reference, this->_measure, this->_output,
+                                this->_output != new_u});
 }
 
-void RST::reset(void) {
+template <typename T>
+void RST<T>::reset(void) {
     _R.reset();
     _Sp.reset();
     _T.reset();
     this->_output = 0;
 }
 
+template class RST<float32_t>;
+template class RST<float64_t>;
 
+} // namespace ot
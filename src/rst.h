@@ -26,6 +26,8 @@
 #include "controller.h"
 #include "fir.h" 
 
+namespace ot {
+
 /**
  * @class RstParams structure of Rst parameters
  * @brief 
@@ -48,17 +50,19 @@
  *
  * @param upper_bound maximal value of output
  *
+ * @tparam T scalar type
  */
+template <typename T = ot_scalar_t>
 struct RstParams {
-    float32_t Ts;
+    T Ts;
     uint8_t nr;
-    const float32_t *r;
+    const T *r;
     uint8_t ns;
-    const float32_t *s;
+    const T *s;
     uint8_t nt;
-    const float32_t *t;
-    float32_t lower_bound;
-    float32_t upper_bound;
+    const T *t;
+    T lower_bound;
+    T upper_bound;
 };
 
 
@@ -77,29 +81,38 @@ struct RstParams {
  * some classical regulators can be implemented by its way like pid and pr.
  *
  */
-class RST: public Controller<float32_t, float32_t, float32_t, RstParams> {
+template <typename T = ot_scalar_t>
+class RST: public Controller<T, T, T, RstParams<T>, T> {
 public:
     RST() {};
+    // it owns its Fir: movable, not copyable.
+    RST(RST &&) = default;
+    RST &operator=(RST &&) = default;
 
     /**
      * @brief initialize the rst controller 
      *
      * @param p RstParams structure
-     * @return 0 if ok -EINVAL if not
+     * @return 0 if ok, -EINVAL if the parameters are not correct, -ENOMEM if
+     * the Fir storage can not be allocated.
      */
-    int8_t init(RstParams p) override;
+    int8_t init(RstParams<T> p) override;
 
     void calculate(void) override;
 
-    using Controller<float32_t, float32_t, float32_t, RstParams>::calculate;
+    using Controller<T, T, T, RstParams<T>, T>::calculate;
 
     void reset(void) override;
 
 private:
-    Fir _R;
-    Fir _Sp;
-    Fir _T;
-    float32_t _inv_s0;
+    Fir<T> _R;
+    Fir<T> _Sp;
+    Fir<T> _T;
+    T _inv_s0;
 };
 
+} // namespace ot
+
+typedef ot::RstParams<> RstParams;
+typedef ot::RST<> RST;
 #endif
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date 2024
+ * @author Régis Ruelland <regis.ruelland@laas.fr>
+ */
+
+/**
+ * @file scalar.h
+ * @brief scalar type used by the library.
+ *
+ * All the classes of the library are templates in the `ot` namespace taking
+ * the scalar type as parameter, e.g. `ot::Pid<float64_t>`. They are explicitly
+ * instantiated for `float32_t` and `float64_t`.
+ *
+ * The usual names (`Pid`, `Pr`, `RST`, `Fir`, `three_phase_t`, ...) are aliases
+ * on `ot_scalar_t` which is `float32_t` by default. Define
+ * `CONTROL_LIB_USE_DOUBLE` to build them in double precision (host simulation).
+ */
+#ifndef SCALAR_H_
+#define SCALAR_H_
+#include <arm_math.h>
+
+#ifdef CONTROL_LIB_USE_DOUBLE
+typedef float64_t ot_scalar_t;
+#else
+typedef float32_t ot_scalar_t;
+#endif
+
+#endif
@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date 2024
+ * @author Régis Ruelland <regis.ruelland@laas.fr>
+ *
+ * Oscilloscope like capture of internal signals of the control loop.
+ */
+#ifndef SCOPE_H_
+#define SCOPE_H_
+#include <errno.h>
+#include <stdint.h>
+#include <atomic>
+#include "scalar.h"
+
+namespace ot {
+
+/**
+ * @class Scope
+ * @brief captures signals around a trigger event, to be read after.
+ *
+ * The signals are given by their address with `addChannel`, e.g.
+ * `scope.addChannel(&pid.getIntegral())`, `&pll.getW()` or the address of a
+ * field of a `Transform` result kept by the application (`&Xdqo.d`). The
+ * samples are stored in a memory
+ * given by the application with `init`. Once armed, `sample()` called in the
+ * control interrupt copies each signal (one load and one store by channel) in
+ * a ring buffer, every `decimation` calls. When `pre_trigger` samples have
+ * been taken, the trigger is tested on each new sample; after it, the capture
+ * goes on until the buffer is full and is frozen: `read` gives the samples in
+ * chronological order, the trigger being at `pre_trigger`.
+ *
+ * Triggers:
+ * - LEVEL: the signal is >= level,
+ * - RISING_EDGE / FALLING_EDGE: the signal crosses level upward / downward,
+ * - SATURATION: the signal is >= level or <= lower_level (the bounds of a
+ *   controller output).
+ *
+ * @tparam T type of the signals
+ */
+template <typename T = ot_scalar_t>
+class Scope {
+public:
+    static constexpr uint8_t MAX_CHANNELS = 8;
+
+    enum Trigger : uint8_t {
+        LEVEL,
+        RISING_EDGE,
+        FALLING_EDGE,
+        SATURATION,
+    };
+
+    enum State : uint8_t {
+        STOPPED,
+        ARMED,
+        TRIGGERED,
+        FROZEN,
+    };
+
+    constexpr Scope() {};
+
+    /**
+     * @param buffer memory of the samples
+     * @param size number of T in `buffer`, the depth of the capture is
+     * size / number of channels.
+     * @return 0 if ok, -EINVAL else.
+     */
+    int8_t init(T *buffer, uint32_t size) {
+        if (buffer == nullptr || size == 0) {
+            return -EINVAL;
+        }
+        _buffer = buffer;
+        _size = size;
+        _channels = 0;
+        _setState(STOPPED);
+        return 0;
+    };
+
+    /**
+     * @brief add a signal to capture, when the scope is not armed.
+     *
+     * @return the index of the channel, -ENOMEM if there are too many
+     * channels, -EBUSY if the scope is armed.
+     */
+    int8_t addChannel(const T *signal) {
+        if (getState() == ARMED || getState() == TRIGGERED) {
+            return -EBUSY;
+        }
+        if (_channels == MAX_CHANNELS || (uint32_t)(_channels + 1) > _size) {
+            return -ENOMEM;
+        }
+        _signals[_channels] = signal;
+        return _channels++;
+    };
+
+    /**
+     * @return 0 if ok, -EINVAL if there is no such channel.
+     */
+    int8_t setTrigger(uint8_t channel, Trigger trigger, T level, T lower_level = 0) {
+        if (channel >= _channels) {
+            return -EINVAL;
+        }
+        _trigger_channel = channel;
+        _trigger = trigger;
+        _level = level;
+        _lower_level = lower_level;
+        return 0;
+    };
+
+    /**
+     * @brief start a capture.
+     *
+     * @param pre_trigger number of samples kept before the trigger
+     * @param decimation one call of `sample` in `decimation` is captured
+     * @return 0 if ok, -EINVAL if there is no channel or if pre_trigger >= depth.
+     */
+    int8_t arm(uint32_t pre_trigger, uint16_t decimation = 1) {
+        if (_channels == 0 || pre_trigger >= getDepth() || decimation == 0) {
+            return -EINVAL;
+        }
+        _setState(STOPPED);
+        _depth = getDepth();
+        _pre_trigger = pre_trigger;
+        _decimation = decimation;
+        _decimation_count = 0;
+        _write = 0;
+        _taken = 0;
+        _first = true;
+        _force = false;
+        _setState(ARMED);
+        return 0;
+    };
+
+    /**
+     * @brief trigger the capture now, whatever the trigger condition.
+     */
+    void forceTrigger(void) {
+        std::atomic_ref<bool>(_force).store(true, std::memory_order_relaxed);
+    };
+
+    void stop(void) {
+        _setState(STOPPED);
+    };
+
+    /**
+     * @brief capture the signals, to call at each sample time.
+     */
+    inline void sample(void) {
+        uint8_t state = _state;
+        if (state != ARMED && state != TRIGGERED) {
+            return;
+        }
+        if (++_decimation_count < _decimation) {
+            return;
+        }
+        _decimation_count = 0;
+        T *row = _buffer + _write * _channels;
+        for (uint8_t k = 0; k < _channels; k++) {
+            row[k] = *_signals[k];
+        }
+        _write = (_write + 1 == _depth) ? 0 : _write + 1;
+        if (state == ARMED) {
+            T value = row[_trigger_channel];
+            if (_taken < _pre_trigger) {
+                _taken++;
+            } else if (_triggered(value)
+                       || std::atomic_ref<bool>(_force).load(std::memory_order_relaxed)) {
+                std::atomic_ref<bool>(_force).store(false, std::memory_order_relaxed);
+                _post_trigger = _depth - _pre_trigger - 1;
+                _setState(_post_trigger == 0 ? FROZEN : TRIGGERED);
+            }
+            _previous = value;
+            _first = false;
+        } else if (--_post_trigger == 0) {
+            _setState(FROZEN);
+        }
+    };
+
+    State getState(void) const {
+        return (State)std::atomic_ref<uint8_t>(_state).load(std::memory_order_acquire);
+    };
+
+    /**
+     * @brief number of samples of a capture.
+     */
+    uint32_t getDepth(void) const {
+        return (_channels == 0) ? 0 : _size / _channels;
+    };
+
+    /**
+     * @brief sample `index` of a frozen capture, in chronological order.
+     */
+    T read(uint32_t index, uint8_t channel) const {
+        uint32_t row = _write + index;
+        if (row >= getDepth()) {
+            row -= getDepth();
+        }
+        return _buffer[row * _channels + channel];
+    };
+
+private:
+    inline bool _triggered(T value) const {
+        switch (_trigger) {
+            case LEVEL:
+                return value >= _level;
+            case RISING_EDGE:
+                return !_first && _previous < _level && value >= _level;
+            case FALLING_EDGE:
+                return !_first && _previous > _level && value <= _level;
+            case SATURATION:
+                return value >= _level || value <= _lower_level;
+        }
+        return false;
+    };
+
+    void _setState(State state) {
+        std::atomic_ref<uint8_t>(_state).store(state, std::memory_order_release);
+    };
+
+    T *_buffer = nullptr;
+    uint32_t _size = 0;
+    const T *_signals[MAX_CHANNELS]{};
+    uint8_t _channels = 0;
+    uint8_t _trigger_channel = 0;
+    uint8_t _trigger = LEVEL;
+    T _level{};
+    T _lower_level{};
+    T _previous{};
+    bool _first = true;
+    alignas(std::atomic_ref<bool>::required_alignment) bool _force = false;
+    uint16_t _decimation = 1;
+    uint16_t _decimation_count = 0;
+    uint32_t _pre_trigger = 0;
+    uint32_t _post_trigger = 0;
+    uint32_t _taken = 0;
+    uint32_t _depth = 0;
+    uint32_t _write = 0;
+    alignas(std::atomic_ref<uint8_t>::required_alignment) mutable uint8_t _state = STOPPED;
+};
+
+} // namespace ot
+
+#endif
@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date 2024
+ * @author Régis Ruelland <regis.ruelland@laas.fr>
+ *
+ * Multi input multi output controllers and observers in state space form.
+ */
+#ifndef STATE_SPACE_H_
+#define STATE_SPACE_H_
+#include <errno.h>
+#include <stddef.h>
+#include <array>
+#include "controller.h"
+
+namespace ot {
+
+/**
+ * @class StateSpaceParams
+ * @brief matrices of a discrete state space controller.
+ *
+ *  u(k)   = C x(k) + Dr r(k) + Dy y(k), saturated
+ *  x(k+1) = A x(k) + Br r(k) + By y(k) + Bu u(k)
+ *
+ * r is the reference, y the measure and u the saturated output. `Bu` feeds
+ * back the output really applied: an observer of the plant (A - L C, Bu = B,
+ * By = L) stays consistent when the output saturates, which avoids the
+ * windup of the controller states.
+ *
+ * @param Ts sample time
+ *
+ * @param lower_bound min value of each output
+ *
+ * @param upper_bound max value of each output
+ *
+ * @tparam Nx number of states
+ * @tparam Nu number of outputs (inputs of the plant)
+ * @tparam Ny number of measures and references
+ * @tparam T scalar type
+ */
+template <size_t Nx, size_t Nu, size_t Ny, typename T = ot_scalar_t>
+struct StateSpaceParams {
+    T Ts;
+    T A[Nx][Nx];
+    T Br[Nx][Ny];
+    T By[Nx][Ny];
+    T Bu[Nx][Nu];
+    T C[Nu][Nx];
+    T Dr[Nu][Ny];
+    T Dy[Nu][Ny];
+    std::array<T, Nu> lower_bound;
+    std::array<T, Nu> upper_bound;
+};
+
+/**
+ * @class StateSpace
+ * @brief discrete state space controller with compile time dimensions.
+ *
+ * The matrices are stored in the object and the products have constant
+ * sizes, so the compiler unrolls and vectorizes them. A diagonal `A` (modal
+ * realization with real poles) is detected by `init` and costs Nx products
+ * instead of Nx², and a zero `Bu` is skipped.
+ *
+ * Each output is saturated between its own bounds.
+ *
+ * @tparam Nx number of states
+ * @tparam Nu number of outputs
+ * @tparam Ny number of measures and references
+ * @tparam T scalar type
+ */
+template <size_t Nx, size_t Nu, size_t Ny, typename T = ot_scalar_t>
+class StateSpace: public Controller<std::array<T, Ny>, std::array<T, Ny>, std::array<T, Nu>,
+                                    StateSpaceParams<Nx, Nu, Ny, T>, T> {
+public:
+    typedef std::array<T, Nx> State;
+    typedef std::array<T, Nu> Output;
+    typedef std::array<T, Ny> Input;
+
+    StateSpace() {};
+
+    /**
+     * @brief check the parameters of a StateSpace
+     *
+     * @return nullptr if ok, the error message else.
+     */
+    static constexpr const char *checkParams(const StateSpaceParams<Nx, Nu, Ny, T> &p) {
+        if (!(p.Ts > 0.0))
+            return "Ts must be > 0";
+        for (size_t i = 0; i < Nu; i++) {
+            if (p.lower_bound[i] > p.upper_bound[i])
+                return "lower bound > upper_bound";
+        }
+        return nullptr;
+    };
+
+    /**
+     * @return 0 if ok, -EINVAL if Ts <= 0 or a lower bound is above its upper bound.
+     */
+    int8_t init(StateSpaceParams<Nx, Nu, Ny, T> p) override {
+        const char *error = checkParams(p);
+        if (error != nullptr) {
+            ot_invalid_parameters(error);
+            return -EINVAL;
+        }
+        _p = p;
+        this->_Ts = p.Ts;
+        this->_lower_bound = p.lower_bound;
+        this->_upper_bound = p.upper_bound;
+        _diagonal = true;
+        _output_feedback = false;
+        for (size_t i = 0; i < Nx; i++) {
+            for (size_t j = 0; j < Nx; j++) {
+                _diagonal = _diagonal && (i == j || p.A[i][j] == 0.0);
+            }
+            for (size_t j = 0; j < Nu; j++) {
+                _output_feedback = _output_feedback || p.Bu[i][j] != 0.0;
+            }
+        }
+        reset();
+        return 0;
+    };
+
+    void calculate(void) override {
+        OT_CYCLES_SCOPE(this->_cycles);
+        const Input &r = this->_reference;
+        const Input &y = this->_measure;
+        Output u{};
+        multiplyAdd(_p.C, _x, u);
+        multiplyAdd(_p.Dr, r, u);
+        multiplyAdd(_p.Dy, y, u);
+        this->_output = saturate(u);
+
+        State x{};
+        if (_diagonal) {
+            for (size_t i = 0; i < Nx; i++) {
+                x[i] = _p.A[i][i] * _x[i];
+            }
+        } else {
+            multiplyAdd(_p.A, _x, x);
+        }
+        multiplyAdd(_p.Br, r, x);
+        multiplyAdd(_p.By, y, x);
+        if (_output_feedback) {
+            multiplyAdd(_p.Bu, this->_output, x);
+        }
+        _x = x;
+        OT_RECORD(this->_recorder, {r, y, this->_output, this->_output != u});
+    };
+
+    void reset(void) override {
+        _x = State{};
+        this->_output = Output{};
+    };
+
+    /**
+     * @brief limit each output between its bounds.
+     */
+    Output saturate(Output u) override {
+        for (size_t i = 0; i < Nu; i++) {
+            u[i] = u[i] > this->_upper_bound[i] ? this->_upper_bound[i] : u[i];
+            u[i] = u[i] < this->_lower_bound[i] ? this->_lower_bound[i] : u[i];
+        }
+        return u;
+    };
+
+    /**
+     * @brief change the bounds, if each lower bound is below its upper bound.
+     */
+    void setBounds(Output lower, Output upper) override {
+        for (size_t i = 0; i < Nu; i++) {
+            if (lower[i] > upper[i]) {
+                return;
+            }
+        }
+        this->_lower_bound = lower;
+        this->_upper_bound = upper;
+    };
+
+    /**
+     * @brief states of the controller, the estimated states of the plant for
+     * an observer based controller.
+     */
+    const State &getState(void) const {
+        return _x;
+    };
+
+    /**
+     * @brief set the states, e.g. to start without transient.
+     */
+    void setState(const State &x) {
+        _x = x;
+    };
+
+private:
+    template <size_t R, size_t K>
+    static void multiplyAdd(const T (&M)[R][K], const std::array<T, K> &v, std::array<T, R> &result) {
+        for (size_t i = 0; i < R; i++) {
+            T sum = result[i];
+            for (size_t j = 0; j < K; j++) {
+                sum += M[i][j] * v[j];
+            }
+            result[i] = sum;
+        }
+    };
+
+    StateSpaceParams<Nx, Nu, Ny, T> _p{};
+    State _x{};
+    bool _diagonal{};
+    bool _output_feedback{};
+};
+
+} // namespace ot
+
+#endif
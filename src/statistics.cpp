@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date 2024
+ * @author Régis Ruelland <regis.ruelland@laas.fr>
+ */
+#include <errno.h>
+#include <math.h>
+#include <zephyr/logging/log.h>
+#include "statistics.h"
+#include "no_heap.h"
+
+LOG_MODULE_DECLARE(ot_control);
+
+namespace ot {
+
+/*** MovingAverage ***********************************************************/
+template <typename T>
+int8_t MovingAverage<T>::init(T *buffer, uint16_t size) {
+    if (buffer == nullptr || size == 0) {
+        LOG_ERR("nullptr on buffer or size = 0");
+        return -EINVAL;
+    }
+    _buffer = buffer;
+    _size = size;
+    _inverse_size = T(1.0) / size;
+    reset();
+    return 0;
+}
+
+template <typename T>
+T MovingAverage<T>::calculateWithReturn(T signal) {
+    _sum += signal - _buffer[_position];
+    _fresh_sum += signal;
+    _buffer[_position] = signal;
+    if (++_position == _size) {
+        // the window has been renewed: its exact sum replaces the running one
+        _position = 0;
+        _sum = _fresh_sum;
+        _fresh_sum = 0.0;
+    }
+    return _sum * _inverse_size;
+}
+
+template <typename T>
+void MovingAverage<T>::reset(void) {
+    for (uint16_t k = 0; k < _size; k++) {
+        _buffer[k] = 0.0;
+    }
+    _position = 0;
+    _sum = 0.0;
+    _fresh_sum = 0.0;
+}
+
+/*** MovingStatistics ********************************************************/
+template <typename T>
+int8_t MovingStatistics<T>::init(T *buffer, uint16_t size) {
+    if (buffer == nullptr || size == 0) {
+        LOG_ERR("nullptr on buffer or size = 0");
+        return -EINVAL;
+    }
+    _buffer = buffer;
+    _size = size;
+    _inverse_size = T(1.0) / size;
+    reset();
+    return 0;
+}
+
+template <typename T>
+T MovingStatistics<T>::calculateWithReturn(T signal) {
+    if (_position == 0) {
+        _fresh_shift = signal;
+    }
+    T old = _buffer[_position] - _shift;
+    T deviation = signal - _shift;
+    T fresh = signal - _fresh_shift;
+    _sum += deviation - old;
+    _square_sum += deviation * deviation - old * old;
+    _fresh_sum += fresh;
+    _fresh_square_sum += fresh * fresh;
+    _buffer[_position] = signal;
+    if (++_position == _size) {
+        _position = 0;
+        _shift = _fresh_shift;
+        _sum = _fresh_sum;
+        _square_sum = _fresh_square_sum;
+        _fresh_sum = 0.0;
+        _fresh_square_sum = 0.0;
+    }
+    return getMean();
+}
+
+template <typename T>
+T MovingStatistics<T>::getRms(void) const {
+    T mean = getMean();
+    T mean_square = getVariance() + mean * mean;
+    return mean_square > 0.0 ? sqrt(mean_square) : 0.0;
+}
+
+template <typename T>
+T MovingStatistics<T>::getVariance(void) const {
+    T mean = _sum * _inverse_size;
+    T variance = _square_sum * _inverse_size - mean * mean;
+    return variance > 0.0 ? variance : 0.0;
+}
+
+template <typename T>
+void MovingStatistics<T>::reset(void) {
+    for (uint16_t k = 0; k < _size; k++) {
+        _buffer[k] = 0.0;
+    }
+    _position = 0;
+    _shift = 0.0;
+    _sum = 0.0;
+    _square_sum = 0.0;
+    _fresh_shift = 0.0;
+    _fresh_sum = 0.0;
+    _fresh_square_sum = 0.0;
+}
+
+/*** ExponentialStatistics ***************************************************/
+template <typename T>
+int8_t ExponentialStatistics<T>::init(T Ts, T tau) {
+    if (Ts <= 0.0 || tau <= 0.0) {
+        LOG_ERR("Ts and tau must be > 0");
+        return -EINVAL;
+    }
+    _alpha = 1 - exp(-Ts / tau);
+    reset();
+    return 0;
+}
+
+template <typename T>
+T ExponentialStatistics<T>::calculateWithReturn(T signal) {
+    T difference = signal - _mean;
+    T increment = _alpha * difference;
+    _mean += increment;
+    _variance = (1 - _alpha) * (_variance + difference * increment);
+    return _mean;
+}
+
+template <typename T>
+T ExponentialStatistics<T>::getRms(void) const {
+    return sqrt(_variance + _mean * _mean);
+}
+
+template <typename T>
+void ExponentialStatistics<T>::reset(void) {
+    _mean = 0.0;
+    _variance = 0.0;
+}
+
+template class MovingAverage<float32_t>;
+template class MovingAverage<float64_t>;
+template class MovingStatistics<float32_t>;
+template class MovingStatistics<float64_t>;
+template class ExponentialStatistics<float32_t>;
+template class ExponentialStatistics<float64_t>;
+
+} // namespace ot
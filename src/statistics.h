@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date 2024
+ * @author Régis Ruelland <regis.ruelland@laas.fr>
+ *
+ * Averages and statistics over a sliding window or exponentially weighted,
+ * in O(1) by sample.
+ */
+#ifndef STATISTICS_H_
+#define STATISTICS_H_
+#include <stdint.h>
+#include "scalar.h"
+
+namespace ot {
+
+/**
+ * @class MovingAverage
+ * @brief mean of the last `size` samples.
+ *
+ * A running sum is updated with the new sample and the one leaving the window.
+ * Its rounding errors would accumulate: each time the window has been
+ * entirely renewed, the sum is replaced by the sum of the samples added since
+ * the previous renewal, which are exactly the window. The cost is O(1) by
+ * sample whatever the size, e.g. one period of 50 Hz at 50 kHz (1000 samples).
+ *
+ * The samples are kept in a memory given by the application, usually static.
+ * Until `size` samples have been given, the missing ones are 0.
+ *
+ * @tparam T scalar type
+ */
+template <typename T = ot_scalar_t>
+class MovingAverage {
+public:
+    MovingAverage() {};
+
+    /**
+     * @param buffer memory of the window
+     * @param size number of samples of the window
+     * @return 0 if ok, -EINVAL if buffer is null or size is 0.
+     */
+    int8_t init(T *buffer, uint16_t size);
+
+    /**
+     * @return the mean of the window with the new sample.
+     */
+    T calculateWithReturn(T signal);
+
+    T getMean(void) const {
+        return _sum * _inverse_size;
+    };
+
+    void reset(void);
+
+private:
+    T *_buffer{};
+    uint16_t _size{};
+    uint16_t _position{};
+    T _inverse_size{};
+    T _sum{};
+    T _fresh_sum{}; // sum of the samples added since the last renewal
+};
+
+/**
+ * @class MovingStatistics
+ * @brief mean, rms and variance of the last `size` samples.
+ *
+ * The sum and the sum of squares are running sums renewed as the one of
+ * `MovingAverage`: O(1) by sample, a square root being only computed by
+ * `getRms`. They are sums of the deviations from a reference, the first
+ * sample of the window they were renewed from: E[x²] - mean² of the raw
+ * samples cancels all the digits of a small ripple on a large offset (1 V
+ * on 400 V in float32_t), the one of the deviations keeps them.
+ *
+ * @tparam T scalar type
+ */
+template <typename T = ot_scalar_t>
+class MovingStatistics {
+public:
+    MovingStatistics() {};
+
+    /**
+     * @param buffer memory of the window
+     * @param size number of samples of the window
+     * @return 0 if ok, -EINVAL if buffer is null or size is 0.
+     */
+    int8_t init(T *buffer, uint16_t size);
+
+    /**
+     * @return the mean of the window with the new sample.
+     */
+    T calculateWithReturn(T signal);
+
+    T getMean(void) const {
+        return _shift + _sum * _inverse_size;
+    };
+
+    T getRms(void) const;
+
+    /**
+     * @brief variance of the window (divided by `size`).
+     */
+    T getVariance(void) const;
+
+    void reset(void);
+
+private:
+    T *_buffer{};
+    uint16_t _size{};
+    uint16_t _position{};
+    T _inverse_size{};
+    T _shift{};
+    T _sum{};
+    T _square_sum{};
+    T _fresh_shift{};
+    T _fresh_sum{};
+    T _fresh_square_sum{};
+};
+
+/**
+ * @class ExponentialStatistics
+ * @brief mean, rms and variance exponentially weighted with a time constant,
+ * without memory of the samples.
+ *
+ *  mean(k)     = mean(k-1) + alpha (x - mean(k-1))
+ *  variance(k) = (1 - alpha) (variance(k-1) + alpha (x - mean(k-1))²)
+ *
+ * with alpha = 1 - exp(-Ts / tau).
+ *
+ * @tparam T scalar type
+ */
+template <typename T = ot_scalar_t>
+class ExponentialStatistics {
+public:
+    ExponentialStatistics() {};
+
+    /**
+     * @param Ts sample time [s]
+     * @param tau time constant [s]
+     * @return 0 if ok, -EINVAL if Ts or tau <= 0.
+     */
+    int8_t init(T Ts, T tau);
+
+    /**
+     * @return the mean with the new sample.
+     */
+    T calculateWithReturn(T signal);
+
+    T getMean(void) const {
+        return _mean;
+    };
+
+    T getRms(void) const;
+
+    T getVariance(void) const {
+        return _variance;
+    };
+
+    void reset(void);
+
+private:
+    T _alpha{};
+    T _mean{};
+    T _variance{};
+};
+
+} // namespace ot
+
+typedef ot::MovingAverage<> MovingAverage;
+typedef ot::MovingStatistics<> MovingStatistics;
+typedef ot::ExponentialStatistics<> ExponentialStatistics;
+#endif
@@ -1,30 +1,45 @@
 #include "transform.h"
+#include "no_heap.h"
 
-clarke_t Transform::clarke(three_phase_t Xabc)
+namespace ot {
+
+/*
+ * 1/√3 and √3/2 in the precision of the scalar type, SQRT3_INVERSE and
+ * SQRT3_DIV_2 are the float32_t ones.
+ */
+template <typename T>
+static constexpr T sqrt3_inverse = T(0.577350269189625764509148780501957456);
+template <typename T>
+static constexpr T sqrt3_div_2 = T(0.866025403784438646763723170752936183);
+
+template <typename T>
+clarke_t<T> Transform<T>::clarke(three_phase_t<T> Xabc)
 {
-	clarke_t Xab;
+	clarke_t<T> Xab;
 	Xab.alpha = 2.0 / 3.0 * (Xabc.a - 0.5 * (Xabc.b + Xabc.c)); 
-	Xab.beta = SQRT3_INVERSE * (Xabc.b - Xabc.c);
+	Xab.beta = sqrt3_inverse<T> * (Xabc.b - Xabc.c);
 	Xab.o = 2.0 / 3.0 * 0.5 * (Xabc.a + Xabc.b + Xabc.c);
 	return Xab;	
 }
 
-three_phase_t Transform::clarke_inverse(clarke_t Xab)
+template <typename T>
+three_phase_t<T> Transform<T>::clarke_inverse(clarke_t<T> Xab)
 {
-	three_phase_t Xabc;
+	three_phase_t<T> Xabc;
 
 	Xabc.a = Xab.alpha + Xab.o;
-	Xabc.b = -0.5  * Xab.alpha  + SQRT3_DIV_2 * Xab.beta + Xab.o; 
-	Xabc.c = -0.5  * Xab.alpha  - SQRT3_DIV_2 * Xab.beta + Xab.o; 
+	Xabc.b = -0.5  * Xab.alpha  + sqrt3_div_2<T> * Xab.beta + Xab.o; 
+	Xabc.c = -0.5  * Xab.alpha  - sqrt3_div_2<T> * Xab.beta + Xab.o; 
 
 	return Xabc;
 }
 
-dqo_t Transform::rotation_to_dqo(clarke_t Xab, float32_t theta)
+template <typename T>
+dqo_t<T> Transform<T>::rotation_to_dqo(clarke_t<T> Xab, T theta)
 {
-	dqo_t Xdq;
-	float32_t cos_theta = ot_cos(theta);
-	float32_t sin_theta = ot_sin(theta);
+	dqo_t<T> Xdq;
+	T cos_theta = ot_cos(theta);
+	T sin_theta = ot_sin(theta);
 	Xdq.d = Xab.alpha * cos_theta + Xab.beta * sin_theta;
 	Xdq.q = - Xab.alpha * sin_theta + Xab.beta * cos_theta;
 	Xdq.o = Xab.o;
@@ -32,12 +47,13 @@ dqo_t Transform::rotation_to_dqo(clarke_t Xab, float32_t theta)
 	return Xdq;
 }
 
-clarke_t Transform::rotation_to_clarke(dqo_t Xdq, float32_t theta)
+template <typename T>
+clarke_t<T> Transform<T>::rotation_to_clarke(dqo_t<T> Xdq, T theta)
 {
 	// FIXME: change the way to have rotation_to_clarke and rotation_to_clarke equals
-	clarke_t Xab;
-	float32_t cos_theta = ot_cos(theta);
-	float32_t sin_theta = ot_sin(theta);
+	clarke_t<T> Xab;
+	T cos_theta = ot_cos(theta);
+	T sin_theta = ot_sin(theta);
 	Xab.alpha = Xdq.d * cos_theta - Xdq.q * sin_theta;
 	Xab.beta = + Xdq.d * sin_theta + Xdq.q * cos_theta;
 	Xab.o = Xdq.o;
@@ -46,14 +62,19 @@ clarke_t Transform::rotation_to_clarke(dqo_t Xdq, float32_t theta)
 
 }
 
-dqo_t Transform::to_dqo(three_phase_t Xabc, float32_t theta) 
+template <typename T>
+dqo_t<T> Transform<T>::to_dqo(three_phase_t<T> Xabc, T theta) 
 {
-	return Transform::rotation_to_dqo(Transform::clarke(Xabc), theta);	
+	return Transform<T>::rotation_to_dqo(Transform<T>::clarke(Xabc), theta);	
 };
 
-three_phase_t Transform::to_threephase(dqo_t Xdq, float32_t theta) 
+template <typename T>
+three_phase_t<T> Transform<T>::to_threephase(dqo_t<T> Xdq, T theta) 
 {
-	return Transform::clarke_inverse(Transform::rotation_to_clarke(Xdq, theta));	
+	return Transform<T>::clarke_inverse(Transform<T>::rotation_to_clarke(Xdq, theta));	
 };
 
+template class Transform<float32_t>;
+template class Transform<float64_t>;
 
+} // namespace ot
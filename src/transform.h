@@ -33,37 +33,43 @@
 const float32_t SQRT3_INVERSE  = 0.57735026F;
 const float32_t SQRT3_DIV_2    = 0.8660254F;
 
+namespace ot {
 
 /**
  * @brief to keep together a,b and c phase values.
  *
+ * @tparam T scalar type
  */
-
+template <typename T = ot_scalar_t>
 struct three_phase_t {
-    float32_t a;
-    float32_t b;
-    float32_t c;
+    T a;
+    T b;
+    T c;
 
 };
 
 /**
  * @brief to keep together α, β and o values.
  *
+ * @tparam T scalar type
  */
+template <typename T = ot_scalar_t>
 struct clarke_t {
-    float32_t alpha;
-    float32_t beta;
-    float32_t o;
+    T alpha;
+    T beta;
+    T o;
 };
 
 /**
  * @brief to keep together d, q and o values.
  *
+ * @tparam T scalar type
  */
+template <typename T = ot_scalar_t>
 struct dqo_t {
-    float32_t d;
-    float32_t q;
-    float32_t o;
+    T d;
+    T q;
+    T o;
 };
 
 /** 
@@ -73,33 +79,43 @@ struct dqo_t {
  * 1. abc :three phase
  * 2. \f$\alpha, \beta, o\f$ : clarke.
  * 3. d, q, o : direct-quadrature.
+ *
+ * @tparam T scalar type
  */
+template <typename T = ot_scalar_t>
 class Transform
 {
 public:
     /**
      * @brief make a -\f$\theta\f$ rotation which transform a clarke_t vector to a dqo_t vector.
      */
-    static dqo_t rotation_to_dqo(clarke_t Xabo, float32_t theta);
+    static dqo_t<T> rotation_to_dqo(clarke_t<T> Xabo, T theta);
     /**
      * @brief make a \f$\theta\f$ rotation which transform a dqo_t vector to a clarke_t vector. 
      */
-    static clarke_t rotation_to_clarke(dqo_t Xdqo, float32_t theta);
+    static clarke_t<T> rotation_to_clarke(dqo_t<T> Xdqo, T theta);
     /**
      * @brief transform a three_phase_t vector to a clarke_t vector.
      */
-    static clarke_t clarke(three_phase_t Xabc);
+    static clarke_t<T> clarke(three_phase_t<T> Xabc);
     /**
      * @brief transform a clarke_t vector to a three_phase_t vector. 
      */
-    static three_phase_t clarke_inverse(clarke_t Xabo);
+    static three_phase_t<T> clarke_inverse(clarke_t<T> Xabo);
     /**
      * @brief transform a three_phase_t vector to a dqo_t vector. 
      */
-    static dqo_t to_dqo(three_phase_t Xabc, float32_t theta);
+    static dqo_t<T> to_dqo(three_phase_t<T> Xabc, T theta);
     /**
      * @brief transform a dqo_t vector to a three_phase_t vector. 
      */
-    static three_phase_t to_threephase(dqo_t Xdqo, float32_t theta);
+    static three_phase_t<T> to_threephase(dqo_t<T> Xdqo, T theta);
 };
+
+} // namespace ot
+
+typedef ot::three_phase_t<> three_phase_t;
+typedef ot::clarke_t<> clarke_t;
+typedef ot::dqo_t<> dqo_t;
+typedef ot::Transform<> Transform;
 #endif
@@ -34,6 +34,7 @@
  */
 
 #include "trigo.h"
+#include "no_heap.h"
 
 const uint32_t MODULO_SIZE     = 32767;  // 2**15-1
 const float32_t INV_MODULO_RES = 32767.0 / (2.0 * PI);
@@ -48,6 +49,14 @@ float32_t ot_cos(float32_t x) {
         return arm_cos_f32(x);
 };
 
+float64_t ot_sin(float64_t x) {
+        return sin(x);
+};
+
+float64_t ot_cos(float64_t x) {
+        return cos(x);
+};
+
 #ifdef CORDIC
 float32_t ot_atan2(float32_t y, float32_t x) {
 
@@ -93,3 +102,22 @@ float32_t ot_modulo_2pi(float32_t x)
     return x - ((float32_t) quotient * 2.0*PI);
 }
 
+
+float64_t ot_modulo_2pi(float64_t x)
+{
+    float64_t division;
+    int64_t quotient;
+    const float64_t inverse_2pi = 1.591549430918953357688837633725143620e-1;
+    const float64_t two_pi = 6.283185307179586476925286766559005768;
+
+    division = x * inverse_2pi;
+
+    quotient = (int64_t) division;
+
+    if (x < 0.0)
+    {
+        quotient--;
+    }
+
+    return x - ((float64_t) quotient * two_pi);
+}
@@ -27,7 +27,10 @@
  * @brief some trigonometrics functions 
  */
 
+#ifndef TRIGO_H_
+#define TRIGO_H_
 #include <arm_math.h>
+#include "scalar.h"
 extern const uint32_t MODULO_SIZE;     
 extern const float32_t INV_MODULO_RES;
 extern const float32_t MODULO_RES; 
@@ -38,7 +41,52 @@ extern const float32_t MODULO_RES;
 #endif
 
 
+/**
+ * @brief Π in the precision of the scalar type `T`.
+ */
+template <typename T>
+constexpr T ot_pi = T(3.141592653589793238462643383279502884);
+
+/*
+ * overloaded for each scalar type: float32_t uses the CMSIS fast math
+ * functions, float64_t uses the libc ones.
+ */
 float32_t ot_sin(float32_t x);
 float32_t ot_cos(float32_t x);
 float32_t ot_modulo_2pi(float32_t theta);
 
+float64_t ot_sin(float64_t x);
+float64_t ot_cos(float64_t x);
+float64_t ot_modulo_2pi(float64_t theta);
+
+/**
+ * @brief cosinus which can be evaluated at compile time, to compute the
+ * coefficients of controllers with constant parameters.
+ *
+ * the angle is reduced to [0, Π/2] then a Taylor series is summed in double
+ * precision. It is slow: use `ot_cos` at run time.
+ */
+template <typename T>
+constexpr T ot_constexpr_cos(T x) {
+    const float64_t pi = ot_pi<float64_t>;
+    float64_t angle = x;
+    int64_t turns = (int64_t)(angle / (2.0 * pi) + (angle < 0.0 ? -0.5 : 0.5));
+    angle = angle - (float64_t) turns * 2.0 * pi;
+    if (angle < 0.0)
+        angle = -angle;
+    float64_t sign = 1.0;
+    if (angle > 0.5 * pi) {
+        angle = pi - angle;
+        sign = -1.0;
+    }
+    float64_t square = angle * angle;
+    float64_t term = 1.0;
+    float64_t sum = 1.0;
+    for (int32_t n = 1; n < 12; n++) {
+        term = -term * square / (float64_t) ((2 * n - 1) * (2 * n));
+        sum += term;
+    }
+    return (T) (sign * sum);
+}
+
+#endif
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date 2024
+ * @author Régis Ruelland <regis.ruelland@laas.fr>
+ */
+#ifndef TRIPLE_BUFFER_H_
+#define TRIPLE_BUFFER_H_
+#include <stdint.h>
+#include <atomic>
+
+namespace ot {
+
+/**
+ * @class TripleBuffer
+ * @brief three sets to pass the last published one from a writer to a reader
+ * running in another context: the coefficients of a controller retuned from a
+ * thread while the control interrupt uses them, or the values of a `Mailbox`.
+ *
+ * - the reader (the `calculate` method) takes the index of the last published
+ *   set with `acquire`, reads it with `get`, and calls `release` when it has
+ *   finished.
+ * - the writer (only one at a time) modifies the set given by `edit`, which is
+ *   a copy of the last published one, then publishes it with `publish`.
+ *
+ * The writer owns one set, the reader another and the third is in the middle:
+ * `publish` and `acquire` only exchange their set with the middle one with an
+ * atomic exchange. Neither side ever waits, whatever the priorities of their
+ * contexts, and a set is never modified while it is read. Sets published
+ * between two `acquire` are skipped, only the last one is read.
+ *
+ * `init` and `active` are not protected: they are used during initialisation.
+ *
+ * @tparam C structure of the coefficients.
+ */
+template <typename C>
+class TripleBuffer {
+public:
+    constexpr TripleBuffer() {};
+
+    /**
+     * @brief set all the sets to `set` and publish it.
+     */
+    constexpr void init(const C &set) {
+        _sets[0] = set;
+        _sets[1] = set;
+        _sets[2] = set;
+        _write = 0;
+        _read = 1;
+        _middle = 2;
+        _published = 1;
+    };
+
+    /**
+     * @brief last published set.
+     */
+    constexpr C &active() {
+        return _sets[_published];
+    };
+
+    constexpr const C &active() const {
+        return _sets[_published];
+    };
+
+    /**
+     * @brief index returned by `acquire` after `init`, until the next `publish`.
+     */
+    constexpr uint8_t activeIndex() const {
+        return _published;
+    };
+
+    /**
+     * @brief reader side: true when a set has been published since the last
+     * `acquire`.
+     */
+    bool fresh() {
+        return (std::atomic_ref<uint8_t>(_middle).load(std::memory_order_relaxed) & FRESH) != 0;
+    };
+
+    /**
+     * @brief reader side: take the last published set.
+     *
+     * @return the index of the set to read with `get`, it changes only when a
+     * new set has been published.
+     */
+    uint8_t acquire() {
+        if (fresh()) {
+            uint8_t previous = std::atomic_ref<uint8_t>(_middle).exchange(_read,
+                                                                         std::memory_order_acq_rel);
+            _read = previous & INDEX;
+        }
+        return _read;
+    };
+
+    const C &get(uint8_t index) const {
+        return _sets[index];
+    };
+
+    /**
+     * @brief reader side: mark the end of a read. The set stays the reader's
+     * one until the next `acquire`, nothing has to be done.
+     */
+    void release() {
+    };
+
+    /**
+     * @brief writer side: give the set of the writer, initialized as a copy of
+     * the last published one.
+     */
+    C &edit() {
+        // the published set is only read, by the reader or in the middle
+        _sets[_write] = _sets[_published];
+        return _sets[_write];
+    };
+
+    /**
+     * @brief writer side: publish `set` without copying the last published one
+     * first.
+     */
+    void publish(const C &set) {
+        _sets[_write] = set;
+        publish();
+    };
+
+    /**
+     * @brief writer side: publish the set given by `edit`.
+     */
+    void publish() {
+        uint8_t previous = std::atomic_ref<uint8_t>(_middle).exchange(_write | FRESH,
+                                                                     std::memory_order_acq_rel);
+        _published = _write;
+        _write = previous & INDEX;
+    };
+
+private:
+    static constexpr uint8_t INDEX = 0x03;
+    static constexpr uint8_t FRESH = 0x04;
+
+    C _sets[3]{};
+    uint8_t _write = 0;
+    uint8_t _read = 1;
+    uint8_t _published = 1;
+    alignas(std::atomic_ref<uint8_t>::required_alignment) uint8_t _middle = 2;
+};
+
+} // namespace ot
+
+#endif
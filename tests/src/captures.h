@@ -0,0 +1,23 @@
+// golden captures of tests/vectors: read from the file system when
+// OT_TEST_VECTORS gives their directory (native_posix), embedded in the image
+// otherwise (a board, the host build).
+#ifndef CAPTURES_H_
+#define CAPTURES_H_
+#include <test_vector.h>
+
+#ifdef OT_TEST_VECTORS
+#define OPEN_CAPTURE(reader, name) (reader).open(OT_TEST_VECTORS "/" #name ".otv")
+#else
+alignas(8) inline const uint8_t pid_standard_otv[] = {
+#include "pid_standard.otv.inc"
+};
+alignas(8) inline const uint8_t pr_otv[] = {
+#include "pr.otv.inc"
+};
+alignas(8) inline const uint8_t pll_angle_otv[] = {
+#include "pll_angle.otv.inc"
+};
+#define OPEN_CAPTURE(reader, name) (reader).open(name##_otv, sizeof(name##_otv))
+#endif
+
+#endif
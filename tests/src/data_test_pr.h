@@ -1,262 +0,0 @@
-#include <arm_math.h>
-// datas generated to test behavior
-const uint8_t N_DATAS=50;
-float32_t yref[50] = {
-0,
-0.24868990480899810791,
-0.48175370693206787109,
-0.68454712629318237305,
-0.84432798624038696289,
-0.95105654001235961914,
-0.99802672863006591797,
-0.98228722810745239258,
-0.90482699871063232422,
-0.77051323652267456055,
-0.58778524398803710938,
-0.36812460422515869141,
-0.12533318996429443359,
--0.1253331303596496582,
--0.36812454462051391602,
--0.58778530359268188477,
--0.77051335573196411133,
--0.90482699871063232422,
--0.98228722810745239258,
--0.99802672863006591797,
--0.95105648040771484375,
--0.84432804584503173828,
--0.68454718589782714844,
--0.48175370693206787109,
--0.24868981540203094482,
-1.7484555314695171546e-07,
-0.24868969619274139404,
-0.48175358772277832031,
-0.68454712629318237305,
-0.84432798624038696289,
-0.95105659961700439453,
-0.99802672863006591797,
-0.98228716850280761719,
-0.90482723712921142578,
-0.77051341533660888672,
-0.58778548240661621094,
-0.3681246638298034668,
-0.12533324956893920898,
--0.12533330917358398438,
--0.36812472343444824219,
--0.58778548240661621094,
--0.77051347494125366211,
--0.90482681989669799805,
--0.98228716850280761719,
--0.99802672863006591797,
--0.95105659961700439453,
--0.84432798624038696289,
--0.68454706668853759766,
--0.48175352811813354492,
--0.24868963658809661865};
-
-float32_t ysat[50] = {
-0,
-0,
-0,
-0.16664098203182220459,
-0.4508717954158782959,
-0.71838808059692382812,
-0.8633359074592590332,
-0.85897994041442871094,
-0.74740195274353027344,
-0.59296935796737670898,
-0.43857806921005249023,
-0.29010459780693054199,
-0.12967468798160552979,
--0.059344429522752761841,
--0.26167583465576171875,
--0.45210891962051391602,
--0.61134523153305053711,
--0.72868323326110839844,
--0.79977571964263916016,
--0.82274931669235229492,
--0.79585897922515869141,
--0.71783483028411865234,
--0.58995735645294189453,
--0.41799628734588623047,
--0.21264947950839996338,
-0.011685476638376712799,
-0.23901787400245666504,
-0.45373103022575378418,
-0.64181375503540039062,
-0.79137891530990600586,
-0.89286971092224121094,
-0.93935042619705200195,
-0.92700392007827758789,
-0.85567229986190795898,
-0.72916501760482788086,
-0.55514156818389892578,
-0.34455525875091552734,
-0.11847209930419921875,
--0.094315990805625915527,
--0.28677648305892944336,
--0.46300345659255981445,
--0.62424510717391967773,
--0.76160520315170288086,
--0.85833114385604858398,
--0.89784401655197143555,
--0.87124085426330566406,
--0.78006178140640258789,
--0.63409763574600219727,
--0.44692730903625488281,
--0.23229850828647613525};
-
-float32_t y_nosat[50] = {
-0,
-0,
-0,
-0.16664098203182220459,
-0.49739992618560791016,
-0.86354809999465942383,
-1.1186208724975585938,
-1.187558293342590332,
-1.0887036323547363281,
-0.89559155702590942383,
-0.67955124378204345703,
-0.47323134541511535645,
-0.2703240513801574707,
-0.050214391201734542847,
--0.19544054567813873291,
--0.45146977901458740234,
--0.68608707189559936523,
--0.86688697338104248047,
--0.97404325008392333984,
--1.0039705038070678711,
--0.96436220407485961914,
--0.86630195379257202148,
--0.71904850006103515625,
--0.52964866161346435547,
--0.30583670735359191895,
--0.059049189090728759766,
-0.19481590390205383301,
-0.43724068999290466309,
-0.65021604299545288086,
-0.81894153356552124023,
-0.93309742212295532227,
-0.98676753044128417969,
-0.97777026891708374023,
-0.90715312957763671875,
-0.77914029359817504883,
-0.60132032632827758789,
-0.38464498519897460938,
-0.14293721318244934082,
--0.10810483992099761963,
--0.35217657685279846191,
--0.57361733913421630859,
--0.75844752788543701172,
--0.89514869451522827148,
--0.97524291276931762695,
--0.99373465776443481445,
--0.94942462444305419922,
--0.84504461288452148438,
--0.68714845180511474609,
--0.48572391271591186523,
--0.25354358553886413574};
-
-float32_t usat[50] = {
-0,
-0,
-0.05667476356029510498,
-0.10000000149011611938,
-0.10000000149011611938,
-0.063664667308330535889,
-0.015785237774252891541,
--0.020768182352185249329,
--0.037574633955955505371,
--0.040649250149726867676,
--0.041724417358636856079,
--0.048760283738374710083,
--0.061692096292972564697,
--0.070000000298023223877,
--0.070000000298023223877,
--0.063198618590831756592,
--0.052133660763502120972,
--0.038752306252717971802,
--0.023808844387531280518,
--0.0073095569387078285217,
-0.010618912056088447571,
-0.029134547337889671326,
-0.046684999018907546997,
-0.061478726565837860107,
-0.072043552994728088379,
-0.077549688518047332764,
-0.077804513275623321533,
-0.073041744530200958252,
-0.0637035369873046875,
-0.050344694405794143677,
-0.033665537834167480469,
-0.014587949030101299286,
--0.0057198805734515190125,
--0.025911809876561164856,
--0.044602252542972564697,
--0.060517780482769012451,
--0.070000000298023223877,
--0.070000000298023223877,
--0.067342326045036315918,
--0.065670497715473175049,
--0.0640985146164894104,
--0.05920122191309928894,
--0.048128675669431686401,
--0.030604997649788856506,
--0.0089091295376420021057,
-0.0135852862149477005,
-0.03404130786657333374,
-0.050974875688552856445,
-0.064056918025016784668,
-0.073371462523937225342};
-
-float32_t u_nosat[50] = {
-0,
-0,
-0.05667476356029510498,
-0.11582427471876144409,
-0.1344753652811050415,
-0.10402147471904754639,
-0.045818097889423370361,
--0.0098694171756505966187,
--0.043903533369302749634,
--0.055563692003488540649,
--0.056578580290079116821,
--0.059544347226619720459,
--0.069453038275241851807,
--0.082543201744556427002,
--0.090984612703323364258,
--0.088822975754737854004,
--0.075211964547634124756,
--0.053781706839799880981,
--0.029659165069460868835,
--0.0066085779108107089996,
-0.014063152484595775604,
-0.032755009829998016357,
-0.050034105777740478516,
-0.065525695681571960449,
-0.077815949916839599609,
-0.085158787667751312256,
-0.086345233023166656494,
-0.081177942454814910889,
-0.070388041436672210693,
-0.055203352123498916626,
-0.036915197968482971191,
-0.016675373539328575134,
--0.0044615487568080425262,
--0.025394229218363761902,
--0.04489394649863243103,
--0.06166508793830871582,
--0.074512161314487457275,
--0.082520909607410430908,
--0.085171140730381011963,
--0.082355760037899017334,
--0.074333265423774719238,
--0.061661154031753540039,
--0.045143112540245056152,
--0.025793904438614845276,
--0.0048048137687146663666,
-0.016511261463165283203,
-0.036799743771553039551,
-0.054761718958616256714,
-0.069250278174877166748,
-0.079350456595420837402};
@@ -1,131 +0,0 @@
-#include <arm_math.h>
-// datas generated to test standard pid behavior
-
-float32_t y[] = {
-0.000000,
-0.000000,
-0.314775,
-0.505696,
-0.621496,
-0.691732,
-0.734332,
-0.760170,
-0.775842,
-0.785347,
-0.791113,
-0.794610,
-0.167180,
--0.109559,
--0.142815,
--0.080149,
--0.018728,
-0.010725,
-0.014721,
-0.008445,
-0.002079,
--0.001045,
--0.315409,
--0.506081,
--0.621729,
--0.691873,
--0.734418,
--0.760222,
--0.775874,
--0.785367,
--0.791124,
--0.794617,
--0.167184,
-0.109558,
-0.142816,
-0.080150,
-0.018728,
--0.010725,
--0.014721,
--0.008445,
--0.002079};
-
-float32_t yref[] = {
-0.0,
-1.0,
-1.0,
-1.0,
-1.0,
-1.0,
-1.0,
-1.0,
-1.0,
-1.0,
-1.0,
-0.0,
-0.0,
-0.0,
-0.0,
-0.0,
-0.0,
-0.0,
-0.0,
-0.0,
-0.0,
--1.0,
--1.0,
--1.0,
--1.0,
--1.0,
--1.0,
--1.0,
--1.0,
--1.0,
--1.0,
-0.0,
-0.0,
-0.0,
-0.0,
-0.0,
-0.0,
-0.0,
-0.0,
-0.0,
-0.0};
-
-float32_t u[] = {
-0.000000,
-0.000000,
-0.800000,
-0.800000,
-0.800000,
-0.800000,
-0.800000,
-0.800000,
-0.800000,
-0.800000,
-0.800000,
-0.800000,
--0.800000,
--0.536150,
--0.194079,
-0.016451,
-0.075952,
-0.056126,
-0.020881,
--0.001228,
--0.007734,
--0.005860,
--0.800000,
--0.800000,
--0.800000,
--0.800000,
--0.800000,
--0.800000,
--0.800000,
--0.800000,
--0.800000,
--0.800000,
-0.800000,
-0.536154,
-0.194082,
--0.016449,
--0.075952,
--0.056127,
--0.020881,
-0.001228,
-0.007734};
@@ -8,6 +8,8 @@
 #include <pr.h>
 #include <filters.h>
 #include <transform.h>
+#include <control_factory.h>
+#include "captures.h"
 LOG_MODULE_REGISTER(test_control, LOG_LEVEL_INF);
 
 ZTEST_SUITE(trigo, NULL, NULL, NULL, NULL, NULL);
@@ -61,12 +63,27 @@ ZTEST(trigo, test_modulo_2pi) {
     }
 }
 
+ZTEST(trigo, test_constexpr_cos) {
+    #include "datas_test_trigo.h"
+    static_assert(ot_constexpr_cos(0.0) == 1.0);
+    static_assert(ot_constexpr_cos(ot_pi<float64_t>) == -1.0);
+    float32_t angle;
+    float32_t cos_data;
+    float32_t delta_cos;
+    for (uint8_t k = 0; k< ARRAY_SIZE; k++) {
+        angle = ((float32_t *)random_angles)[k];
+        cos_data = ((float32_t *)random_cos)[k];
+        delta_cos = cos_data - ot_constexpr_cos(angle);
+        zexpect_between_inclusive(delta_cos, -2e-6, 2e-6, "cos(%f): %.6f", angle, delta_cos);
+    }
+}
+
 ZTEST_SUITE(rst, NULL, NULL, NULL, NULL, NULL);
 
 ZTEST(rst, test_fir_update) {
-    float32_t value;
+    ot_scalar_t value;
     Fir myFir = Fir();
-    const float32_t c[4] = {0.25, 0.25, 0.25, 0.25};
+    const ot_scalar_t c[4] = {0.25, 0.25, 0.25, 0.25};
     myFir.init(4, c);
     value = myFir.update(1.0);
     zexpect_equal(value, 0.25, "retvalue = %f", value);
@@ -82,14 +99,14 @@ ZTEST(rst, test_fir_update) {
 
 ZTEST(rst, test_rst_init) {
     RST my_rst;
-    const float r[1] = {1.0};
-    float s[2] = {1.0, 2.0};
-    const float t[1] = {1.0};
+    const ot_scalar_t r[1] = {1.0};
+    ot_scalar_t s[2] = {1.0, 2.0};
+    const ot_scalar_t t[1] = {1.0};
     RstParams p(0.1, 1, r, 2, s, 1, t, 0.0, 1.0); 
     int8_t is_ok = my_rst.init(p);
     zexpect_true(is_ok == 0, "init problem");
 
-    float bad_s[2] = {0.0, 2.0};
+    ot_scalar_t bad_s[2] = {0.0, 2.0};
     p.s = bad_s;
     is_ok = my_rst.init(p);
     zexpect_true(is_ok < 0.0, "init problem");
@@ -99,14 +116,14 @@ ZTEST(rst, test_rst_update) {
     #include "datas_test_rst.h"
     RST my_rst = RST();
     const uint8_t nr = 3;
-    const float R[] = { 0.8914, -1.1521, 0.3732 };
+    const ot_scalar_t R[] = { 0.8914, -1.1521, 0.3732 };
     const uint8_t ns = 6;
-    const float S[] = { 0.2, 0.0852, -0.0134, -0.0045, -0.1785, -0.0888 };
+    const ot_scalar_t S[] = { 0.2, 0.0852, -0.0134, -0.0045, -0.1785, -0.0888 };
     const uint8_t nt = 3;
-    const float T[] = { 1.0, -1.3741, 0.4867 };
+    const ot_scalar_t T[] = { 1.0, -1.3741, 0.4867 };
     RstParams p(5, nr, R, ns, S, nt, T, -5.0, 5.0);
     my_rst.init(p);
-    float32_t u;
+    ot_scalar_t u;
 
     for (uint8_t step=0; step < 20; step++)
     {
@@ -121,9 +138,9 @@ ZTEST(rst, test_rst_limit) {
 }
 
 ZTEST(rst, test_fir_setcoeff) {
-    float32_t value;
+    ot_scalar_t value;
     Fir myFir = Fir();
-    const float32_t c[4] = {0.25, 0.25, 0.25, 0.25};
+    const ot_scalar_t c[4] = {0.25, 0.25, 0.25, 0.25};
     myFir.init(4, c);
     value = myFir.update(1.0);
     zexpect_equal(value, 0.25, "retvalue = %f", value);
@@ -136,6 +153,150 @@ ZTEST(rst, test_fir_setcoeff) {
     zexpect_equal(value, 0.25, "retvalue = %f", value);
 }
 
+ZTEST(rst, test_fir_reinit) {
+    ot_scalar_t value;
+    Fir myFir = Fir();
+    const ot_scalar_t c[4] = {0.25, 0.25, 0.25, 0.25};
+    myFir.init(4, c);
+    ArenaStats before = controlLibArena.getStats();
+    const ot_scalar_t c2[2] = {0.5, 0.5};
+    zexpect_ok(myFir.init(2, c2));
+    ArenaStats after = controlLibArena.getStats();
+    zexpect_equal(before.used, after.used, "used %zu -> %zu", before.used, after.used);
+    value = myFir.update(1.0);
+    zexpect_equal(value, 0.5, "retvalue = %f", value);
+    value = myFir.update(1.0);
+    zexpect_equal(value, 1.0, "retvalue = %f", value);
+}
+
+ZTEST(rst, test_fir_arena_reuse) {
+    const ot_scalar_t c[8] = {0.125, 0.125, 0.125, 0.125, 0.125, 0.125, 0.125, 0.125};
+    ArenaStats before = controlLibArena.getStats();
+    for (int k = 0; k < 100; k++) {
+        // destroyed, growing and moved Fir give their blocks back
+        Fir small = Fir(2, c);
+        Fir big = Fir(4, c);
+        zexpect_ok(big.init(8, c));
+        Fir moved = static_cast<Fir &&>(small);
+    }
+    ArenaStats after = controlLibArena.getStats();
+    zexpect_equal(before.used, after.used, "used %zu -> %zu", before.used, after.used);
+    zexpect_equal(before.free, after.free, "free %zu -> %zu", before.free, after.free);
+    zexpect_equal(before.failures, after.failures);
+}
+
+ZTEST(rst, test_fir_arena_split) {
+    // a smaller Fir in the block of a bigger one gives all its bytes back
+    const ot_scalar_t c[8] = {0.125, 0.125, 0.125, 0.125, 0.125, 0.125, 0.125, 0.125};
+    ArenaStats before = controlLibArena.getStats();
+    {
+        Fir big = Fir(8, c);
+        Fir top = Fir(2, c);
+        big = Fir();
+        ArenaStats freed = controlLibArena.getStats();
+        Fir small = Fir(4, c);
+        zexpect_true(controlLibArena.getStats().free < freed.free);
+        zexpect_equal(controlLibArena.getStats().used, freed.used);
+        small = Fir();
+        ArenaStats after = controlLibArena.getStats();
+        zexpect_equal(after.free, freed.free, "free %zu -> %zu", freed.free, after.free);
+        zexpect_equal(after.used, freed.used);
+    }
+    ArenaStats after = controlLibArena.getStats();
+    zexpect_equal(before.used, after.used, "used %zu -> %zu", before.used, after.used);
+    zexpect_equal(before.free, after.free, "free %zu -> %zu", before.free, after.free);
+}
+
+ZTEST(rst, test_arena_free_list) {
+    const size_t G = Arena::GRANULE;
+    alignas(8) static uint8_t region[8 * Arena::GRANULE];
+    Arena arena = Arena(region, sizeof(region));
+    void *p1 = arena.allocate(2 * G, 4);
+    void *p2 = arena.allocate(2 * G, 4);
+    void *p3 = arena.allocate(4, 4);
+    // not at the top: kept in the free list and reused, its tail stays free
+    arena.deallocate(p1, 2 * G);
+    zexpect_equal(arena.getStats().free, 2 * G);
+    zexpect_equal(arena.allocate(G - 4, 4), p1);
+    zexpect_equal(arena.getStats().free, G);
+    // merged with its tail when given back
+    arena.deallocate(p1, G - 4);
+    zexpect_equal(arena.getStats().free, 2 * G);
+    zexpect_equal(arena.allocate(2 * G, 4), p1);
+    zexpect_equal(arena.getStats().free, 0);
+    // the top returns to the region, with the free blocks below it
+    arena.deallocate(p2, 2 * G);
+    arena.deallocate(p3, 4);
+    ArenaStats stats = arena.getStats();
+    zexpect_equal(stats.used, 2 * G, "used %zu", stats.used);
+    zexpect_equal(stats.free, 0);
+    zexpect_equal(arena.allocate(6 * G, 4), p2);
+}
+
+ZTEST(rst, test_arena) {
+    alignas(8) static uint8_t region[4 * Arena::GRANULE];
+    Arena arena = Arena(region, sizeof(region));
+    void *p1 = arena.allocate(3, 1);
+    void *p2 = arena.allocate(4, 4);
+    zexpect_not_null(p1);
+    zexpect_not_null(p2);
+    zexpect_equal((uintptr_t)p2 % 4, 0);
+    zexpect_true(arena.owns(p2));
+    zexpect_is_null(arena.allocate(3 * Arena::GRANULE, 1));
+    ArenaStats stats = arena.getStats();
+    zexpect_equal(stats.capacity, sizeof(region));
+    // sizes are rounded up to the granule
+    zexpect_equal(stats.used, 2 * Arena::GRANULE);
+    zexpect_equal(stats.allocations, 2);
+    zexpect_equal(stats.failures, 1);
+    zexpect_equal(arena.init(region, sizeof(region)), -EBUSY);
+}
+
+ZTEST(rst, test_fir_move) {
+    ot_scalar_t value;
+    const ot_scalar_t c[2] = {0.5, 0.5};
+    Fir firstFir = Fir(2, c);
+    value = firstFir.update(1.0);
+    Fir secondFir = static_cast<Fir &&>(firstFir);
+    value = secondFir.update(1.0);
+    zexpect_equal(value, 1.0, "retvalue = %f", value);
+    Fir thirdFir;
+    thirdFir = static_cast<Fir &&>(secondFir);
+    value = thirdFir.update(0.0);
+    zexpect_equal(value, 0.5, "retvalue = %f", value);
+}
+
+static ot::sim::TestVectorReader<float32_t> capture;
+
+/*
+ * replays `capture` through `controller`: the output of each frame is the one
+ * given by the reference and measure of the previous frame.
+ */
+template <typename C>
+static void replay_capture(C &controller, const char *measure_name, const char *output_name,
+                           float64_t tolerance) {
+    int16_t reference = capture.channel("reference");
+    int16_t measure = capture.channel(measure_name);
+    int16_t output = capture.channel(output_name);
+    zassert_true(reference >= 0 && measure >= 0 && output >= 0);
+    const float32_t *frame = capture.next();
+    zassert_not_null(frame);
+    // the frame is only valid until the next one is read
+    ot_scalar_t yref = frame[reference];
+    ot_scalar_t y = frame[measure];
+    uint32_t k = 0;
+    while ((frame = capture.next()) != nullptr) {
+        ot_scalar_t out = controller.calculateWithReturn(yref, y);
+        zexpect_within(frame[output], out, tolerance, "k=%u u[k] = %f, controller u = %f",
+                       k, (double)frame[output], (double)out);
+        yref = frame[reference];
+        y = frame[measure];
+        k++;
+    }
+    zexpect_equal(k + 1, capture.frames());
+    capture.close();
+}
+
 // PidStandard
 struct pid_fixture_t {
     PidParams params;
@@ -171,14 +332,8 @@ ZTEST_F(test_pid, test_calculate) {
     pid_fixture_t *pid_fixture = (pid_fixture_t *)fixture;
     pid.init(pid_fixture->params);
     // data with pid saturation activate
-    #include "datas_test_pid_standard.h"
-    int n = sizeof(yref) / sizeof(yref[0]);
-    for (int k=0; k < n-1; k++)
-    {
-        float32_t out = pid.calculateWithReturn(yref[k], y[k]);
-        zexpect_within(u[k+1], out, 5e-6, "k=%d u[k] = %f, pid u = %f", k, u[k+1], out);
-    }
-
+    zassert_ok(OPEN_CAPTURE(capture, pid_standard));
+    replay_capture(pid, "measure", "output", 5e-6);
 }
 
 ZTEST(test_pid, test_null_derivative) {
@@ -202,6 +357,23 @@ ZTEST(test_pid, test_null_derivative) {
 
 }
 
+ZTEST_F(test_pid, test_constinit) {
+    static constinit Pid const_pid(PidParams(5.0, 0.73, 2.735, 0.122, 10.0, -0.8, 0.8));
+    static_assert(Pid::checkParams(PidParams(-1.0F, 0.73F, 2.735F, 0.0F, 0.0F, -0.8F, 0.8F)) != nullptr);
+    pid_fixture_t *pid_fixture = (pid_fixture_t *)fixture;
+    Pid pid;
+    pid.init(pid_fixture->params);
+    // a step of the reference which saturates the output, then a reversal
+    for (int k=0; k < 40; k++)
+    {
+        ot_scalar_t yref = (k < 20) ? 1.0 : -0.5;
+        ot_scalar_t y = 0.02 * k;
+        ot_scalar_t out = pid.calculateWithReturn(yref, y);
+        ot_scalar_t const_out = const_pid.calculateWithReturn(yref, y);
+        zexpect_equal(out, const_out, "k=%d u = %.17g, constinit u = %.17g", k, (double)out, (double)const_out);
+    }
+}
+
 ZTEST_F(test_pid, test_bad_init_values) {
     pid_fixture_t *pid_fixture = (pid_fixture_t *)fixture;
     PidParams params = pid_fixture->params;
@@ -254,15 +426,36 @@ ZTEST(test_pr, test_calculate) {
     PrParams params(Ts, Kp, Kr, w, phi, lower_bound, upper_bound);
     Pr pr;
     pr.init(params);
-    // data with pid saturation activate
-    #include "data_test_pr.h"
-    int n = sizeof(yref) / sizeof(yref[0]);
-    for (int k=0; k < n-1; k++)
-    {
-        float32_t out = pr.calculateWithReturn(yref[k], y_nosat[k]);
-        zexpect_within(u_nosat[k+1], out, 3e-4, "k=%d u[k] = %f, pid u = %f", k, u_nosat[k+1], out);
+    zassert_ok(OPEN_CAPTURE(capture, pr));
+    replay_capture(pr, "measure", "output", 3e-4);
+}
+
+ZTEST(test_pr, test_factory) {
+    static Pr in_place_pr;
+    int8_t is_ok = controlLibFactory.pr(in_place_pr, 1.0e-3F, 0.0F, 1.0F, 314.159F, 0.0F, -1.0F, 1.0F);
+    zexpect_ok(is_ok);
+    Pr returned_pr = controlLibFactory.pr(1.0e-3F, 0.0F, 1.0F, 314.159F, 0.0F, -1.0F, 1.0F);
+    for (int k=0; k<3; k++) {
+        float32_t in_place_output = in_place_pr.calculateWithReturn(1.0, 0.0);
+        float32_t returned_output = returned_pr.calculateWithReturn(1.0, 0.0);
+        zexpect_equal(in_place_output, returned_output);
     }
+    is_ok = controlLibFactory.pr(in_place_pr, 1.0e-3F, 0.0F, 0.0F, 314.159F, 0.0F, -1.0F, 1.0F);
+    zexpect_true(is_ok < 0, "with Kr==0, it should return -EINVAL");
+}
 
+ZTEST(test_pr, test_constexpr_coefficients) {
+    constexpr PrParams params(1.0e-3F, 0.0F, 1.0F, 314.159F, 0.1F, -1.0F, 1.0F);
+    constexpr PrCoefficients coeffs = Pr::coefficients(params);
+    Pr pr;
+    Pr const_pr;
+    pr.init(params);
+    zexpect_ok(const_pr.init(params, coeffs));
+    for (int k=0; k<10; k++) {
+        float32_t output = pr.calculateWithReturn(1.0, 0.0);
+        float32_t const_output = const_pr.calculateWithReturn(1.0, 0.0);
+        zexpect_within(output, const_output, 1e-6);
+    }
 }
 
 ZTEST(test_pr, test_setw0) {
@@ -1,101 +0,0 @@
-const float32_t w_est[100] = {
-289.34068339562,
-289.9325594515569,
-290.51759029126106,
-291.0957864921605,
-291.66715994973134,
-292.2317238474382,
-292.7894926270103,
-293.34048195905154,
-293.8847087139846,
-294.4221909333291,
-294.95294780131246,
-295.47699961681394,
-295.9943677656404,
-296.50507469313345,
-297.0091438771077,
-297.50659980111834,
-297.9974679280581,
-298.48177467408266,
-298.9595473828627,
-299.4308143001625,
-299.89560454874356,
-300.35394810359276,
-300.80587576747234,
-301.25141914679295,
-301.690610627806 ,
-302.1234833531154,
-302.5500711985079,
-302.97040875009856,
-303.38453128179185,
-303.79247473305657,
-304.1942756870122,
-304.58997134882554,
-304.9795995244169,
-305.3631985994733,
-305.7408075187662,
-306.1124657657749,
-306.47821334261045,
-306.83809075024095,
-307.19213896901493,
-307.54039943948163,
-307.8829140435063,
-308.21972508567825,
-308.55087527501064,
-308.87640770692866,
-309.19636584554524,
-309.5107935062225,
-309.81973483841614,
-310.12323430880053,
-310.4213366846739,
-310.71408701764045,
-311.00153062756635,
-311.2837130868106,
-311.5606802047253,
-311.83247801242504,
-312.0991527478228,
-312.36075084093034,
-312.6173188994199,
-312.8689036944478,
-313.11555214673365,
-313.35731131289594,
-313.59422837204147,
-313.8263506126056,
-314.05372541943984,
-314.2764002611484,
-314.49442267766756,
-314.70784026808695,
-314.91670067871064,
-315.1210515913569,
-315.32094071189044,
-315.51641575899066,
-315.7075244531473,
-315.89431450588665,
-316.0768336092224,
-316.25512942532987,
-316.429249576443 ,
-316.5992416349678,
-316.76515311381456,
-316.9270314569435,
-317.08492403012195,
-317.2388781118915,
-317.3889408847429,
-317.53515942649494,
-317.6775807018769,
-317.8162515543109,
-317.9512186978912,
-318.08252870956267,
-318.21022802148775,
-318.3343629136086,
-318.45497950639583,
-318.57212375378464,
-318.6858414362953,
-318.7961781543343,
-318.90317932167716,
-319.0068901591267,
-319.10735568834855,
-319.20462072587645,
-319.29872987729215,
-319.38972753157077,
-319.47765785559284,
-319.56256478882176}; 
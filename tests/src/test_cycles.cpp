@@ -0,0 +1,46 @@
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <cycles.h>
+#include <pid.h>
+
+LOG_MODULE_DECLARE(test_control);
+
+ZTEST_SUITE(test_cycles, NULL, NULL, NULL, NULL, NULL);
+
+ZTEST(test_cycles, test_stats) {
+    ot::CycleStats stats;
+    zexpect_equal(stats.getMin(), 0);
+    zexpect_equal(stats.getMean(), 0);
+    stats.record(0);
+    stats.record(3);
+    stats.record(100);
+    stats.record(1000000);
+    zexpect_equal(stats.getCount(), 4);
+    zexpect_equal(stats.getMin(), 0);
+    zexpect_equal(stats.getMax(), 1000000);
+    zexpect_equal(stats.getMean(), 250025);
+    const uint32_t *histogram = stats.getHistogram();
+    zexpect_equal(histogram[0], 1);
+    zexpect_equal(histogram[1], 1, "3 is in [2, 4[");
+    zexpect_equal(histogram[6], 1, "100 is in [64, 128[");
+    zexpect_equal(histogram[ot::CycleStats::BINS - 1], 1, "longer durations are in the last bin");
+    stats.reset();
+    zexpect_equal(stats.getCount(), 0);
+    zexpect_equal(stats.getMax(), 0);
+}
+
+#ifdef CONTROL_LIB_CYCLES
+ZTEST(test_cycles, test_pid_cycles) {
+    Pid pid(PidParams(100e-6F, 1.0F, 1e-3F, 0.0F, 1.0F, -10.0F, 10.0F));
+    for (int k = 0; k < 100; k++) {
+        pid.calculateWithReturn(1.0F, 0.0F);
+    }
+    const ot::CycleStats &stats = pid.getCycleStats();
+    zexpect_equal(stats.getCount(), 100);
+    zexpect_true(stats.getMin() <= stats.getMean());
+    zexpect_true(stats.getMean() <= stats.getMax());
+    pid.resetCycleStats();
+    zexpect_equal(pid.getCycleStats().getCount(), 0);
+}
+#endif
@@ -0,0 +1,91 @@
+#include <math.h>
+#include <zephyr/ztest.h>
+#include <zephyr/logging/log.h>
+#include <deadbeat.h>
+
+LOG_MODULE_DECLARE(test_control);
+
+ZTEST_SUITE(test_deadbeat, NULL, NULL, NULL, NULL, NULL);
+
+static const float32_t Ts = 100e-6F;
+static const float32_t R = 0.5F;
+static const float32_t L = 2e-3F;
+static const float32_t w = 2.0F * PI * 50.0F;
+static const float32_t Vmax = 400.0F;
+
+/**
+ * @brief R-L load with a back emf rotating at w, the voltage being held in the
+ * α, β frame during a period.
+ */
+struct Load {
+    clarke_t current{};
+    dqo_t emf{50.0F, 20.0F, 0.0F};
+    float32_t theta = 0.3F;
+
+    dqo_t measure(void) {
+        return Transform::rotation_to_dqo(current, theta);
+    };
+
+    void step(dqo_t v_dq) {
+        float32_t a = expf(-R * Ts / L);
+        float32_t b = (1.0F - a) / R;
+        clarke_t v = Transform::rotation_to_clarke(v_dq, theta);
+        clarke_t e = Transform::rotation_to_clarke(emf, theta);
+        current.alpha = a * current.alpha + b * (v.alpha - e.alpha);
+        current.beta = a * current.beta + b * (v.beta - e.beta);
+        theta += w * Ts;
+    };
+};
+
+ZTEST(test_deadbeat, test_one_step) {
+    Deadbeat deadbeat;
+    zassert_equal(deadbeat.init(DeadbeatParams{Ts, R, L, w, Vmax, false}), 0);
+    Load load;
+    dqo_t reference{5.0F, -3.0F, 0.0F};
+    for (int k = 0; k < 5; k++) {
+        dqo_t v = deadbeat.calculateWithReturn(reference, DeadbeatMeasure{load.measure(), load.emf});
+        zexpect_false(deadbeat.isSaturated());
+        load.step(v);
+        dqo_t i = load.measure();
+        zexpect_within(i.d, reference.d, 5e-3F, "k = %d, d = %f", k, (double)i.d);
+        zexpect_within(i.q, reference.q, 5e-3F, "k = %d, q = %f", k, (double)i.q);
+    }
+}
+
+ZTEST(test_deadbeat, test_delay_compensation) {
+    Deadbeat deadbeat;
+    zassert_equal(deadbeat.init(DeadbeatParams{Ts, R, L, w, Vmax, true}), 0);
+    Load load;
+    dqo_t reference{5.0F, -3.0F, 0.0F};
+    dqo_t applied{};
+    for (int k = 0; k < 6; k++) {
+        dqo_t v = deadbeat.calculateWithReturn(reference, DeadbeatMeasure{load.measure(), load.emf});
+        load.step(applied);
+        applied = v;
+        if (k >= 1) {
+            dqo_t i = load.measure();
+            zexpect_within(i.d, reference.d, 5e-3F, "k = %d, d = %f", k, (double)i.d);
+            zexpect_within(i.q, reference.q, 5e-3F, "k = %d, q = %f", k, (double)i.q);
+        }
+    }
+}
+
+ZTEST(test_deadbeat, test_saturation) {
+    Deadbeat deadbeat;
+    zassert_equal(deadbeat.init(DeadbeatParams{Ts, R, L, w, Vmax, false}), 0);
+    Load load;
+    dqo_t reference{100.0F, 100.0F, 0.0F};
+    dqo_t v = deadbeat.calculateWithReturn(reference, DeadbeatMeasure{load.measure(), load.emf});
+    zexpect_true(deadbeat.isSaturated());
+    zexpect_within(sqrtf(v.d * v.d + v.q * v.q), Vmax, 1e-2F);
+    zexpect_true(v.d > 0.0F && v.q > 0.0F, "the angle is kept");
+    deadbeat.setBounds(dqo_t{}, dqo_t{0.0F, 100.0F, 0.0F});
+    v = deadbeat.calculateWithReturn(reference, DeadbeatMeasure{load.measure(), load.emf});
+    zexpect_within(sqrtf(v.d * v.d + v.q * v.q), 100.0F, 1e-3F);
+}
+
+ZTEST(test_deadbeat, test_invalid_params) {
+    Deadbeat deadbeat;
+    zexpect_equal(deadbeat.init(DeadbeatParams{Ts, 0.0F, L, w, Vmax, false}), -EINVAL);
+    zexpect_equal(deadbeat.init(DeadbeatParams{Ts, R, L, w, 0.0F, false}), -EINVAL);
+}
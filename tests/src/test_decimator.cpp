@@ -0,0 +1,97 @@
+#include <math.h>
+#include <zephyr/ztest.h>
+#include <zephyr/logging/log.h>
+#include <decimator.h>
+
+LOG_MODULE_DECLARE(test_control);
+
+ZTEST_SUITE(test_decimator, NULL, NULL, NULL, NULL, NULL);
+
+static const ot_scalar_t coeffs[] = {0.05F, 0.1F, 0.2F, 0.3F, 0.2F, 0.1F, 0.05F};
+
+ZTEST(test_decimator, test_dc_gain) {
+    ot_scalar_t compensator[3];
+    Decimator::compensator(3, compensator);
+    Decimator decimator;
+    zassert_equal(decimator.init(DecimatorParams{8, 3, 3, compensator, 1}), 0);
+    int32_t input[64];
+    for (int k = 0; k < 64; k++) {
+        input[k] = 1000;
+    }
+    ot_scalar_t output[9];
+    for (int block = 0; block < 4; block++) {
+        zassert_equal(decimator.process(input, 64, output), 8);
+    }
+    zexpect_within(output[7], 1000.0F, 1e-2F, "%f", (double)output[7]);
+}
+
+ZTEST(test_decimator, test_polyphase) {
+    // same outputs as filtering each CIC output then keeping one out of 3
+    const uint8_t R = 4, S = 2, D = 3;
+    Decimator decimator;
+    zassert_equal(decimator.init(DecimatorParams{R, S, 7, coeffs, D}), 0);
+    Decimator cic;
+    const ot_scalar_t one = 1.0F;
+    zassert_equal(cic.init(DecimatorParams{R, S, 1, &one, 1}), 0);
+    Fir fir(7, coeffs);
+
+    int32_t input[R * D * 10];
+    for (int k = 0; k < R * D * 10; k++) {
+        input[k] = (int32_t)(1000.0F * sinf(0.01F * k) + 300.0F * ((k % 7) - 3));
+    }
+    ot_scalar_t cic_output[D * 10 + 1];
+    ot_scalar_t output[11];
+    zassert_equal(cic.process(input, R * D * 10, cic_output), D * 10);
+    zassert_equal(decimator.process(input, R * D * 10, output), 10);
+    for (int m = 0; m < D * 10; m++) {
+        ot_scalar_t expected = fir.update(cic_output[m]);
+        if (m % D == D - 1) {
+            zexpect_within(output[m / D], expected, 1e-3F, "m = %d", m);
+        }
+    }
+}
+
+ZTEST(test_decimator, test_ripple_rejection) {
+    // a switching ripple at the output rate of the CIC is in one of its zeros
+    const uint8_t R = 16;
+    Decimator decimator;
+    const ot_scalar_t one = 1.0F;
+    zassert_equal(decimator.init(DecimatorParams{R, 2, 1, &one, 1}), 0);
+    int32_t input[R * 8];
+    for (int k = 0; k < R * 8; k++) {
+        input[k] = 2000 + (int32_t)(500.0F * sinf(2.0F * PI * k / R));
+    }
+    ot_scalar_t output[9];
+    zassert_equal(decimator.process(input, R * 8, output), 8);
+    for (int m = 2; m < 8; m++) {
+        zexpect_within(output[m], 2000.0F, 1.0F, "m = %d: %f", m, (double)output[m]);
+    }
+}
+
+ZTEST(test_decimator, test_block_boundaries) {
+    // blocks which are not multiples of the ratio give the same outputs
+    Decimator whole, split;
+    zassert_equal(whole.init(DecimatorParams{5, 3, 7, coeffs, 2}), 0);
+    zassert_equal(split.init(DecimatorParams{5, 3, 7, coeffs, 2}), 0);
+    int32_t input[100];
+    for (int k = 0; k < 100; k++) {
+        input[k] = (k * 37) % 101;
+    }
+    ot_scalar_t expected[11], output[11];
+    zassert_equal(whole.process(input, 100, expected), 10);
+    uint16_t written = split.process(input, 33, output);
+    written += split.process(&input[33], 67, &output[written]);
+    zassert_equal(written, 10);
+    for (int m = 0; m < 10; m++) {
+        zexpect_within(output[m], expected[m], 1e-4F);
+    }
+}
+
+ZTEST(test_decimator, test_invalid_params) {
+    Decimator decimator;
+    zexpect_equal(decimator.init(DecimatorParams{16, 4, 7, coeffs, 1}), -EINVAL, "gain 2^16");
+    zexpect_equal(decimator.init(DecimatorParams{8, 6, 7, coeffs, 1}), -EINVAL);
+    zexpect_equal(decimator.init(DecimatorParams{8, 2, 7, coeffs, 5}), -EINVAL);
+    zexpect_equal(decimator.init(DecimatorParams{8, 2, 2, coeffs, 3}), -EINVAL);
+    zexpect_equal(decimator.init(DecimatorParams{8, 2, 7, nullptr, 1}), -EINVAL);
+}
@@ -1,7 +1,9 @@
+#include <math.h>
 #include <zephyr/ztest.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 #include <filters.h>
+#include "captures.h"
 
 ZTEST_SUITE(test_filters, NULL, NULL, NULL, NULL, NULL);
 
@@ -27,12 +29,77 @@ ZTEST(test_filters, test_notchfilter) {
     
 }
 
+ZTEST(test_filters, test_constexpr_notchfilter) {
+    #include "datas_test_notch_filter.h"
+    constexpr NotchCoefficients coeffs = NotchFilter::coefficients(1e-3, 50.0, 5.0);
+    NotchFilter aFilter;
+    aFilter.init(1e-3, 50.0, 5.0, coeffs);
+    for (int k=0; k < N_DATAS; k++) {
+        float32_t yfilt = aFilter.calculateWithReturn(yref[k]);
+        zexpect_within(yfilt, y[k], 5e-4, "pb yfilt=%f y[k] = %f, yref[k] = %f", yfilt, y[k], yref[k]);
+    }
+}
+
+ZTEST(test_filters, test_notchfilter_retuning) {
+    // retuned from zero states, it is the filter initialized with the new parameters
+    const float32_t Ts = 1e-4F;
+    const float32_t f0s[] = {50.0F, 51.0F, 49.0F, 120.0F, 1000.0F};
+    for (float32_t f0 : f0s) {
+        NotchFilter retuned(Ts, 50.0F, 5.0F);
+        retuned.setF0(f0);
+        retuned.setBandwidth(10.0F);
+        NotchFilter reference(Ts, f0, 10.0F);
+        for (int k = 0; k < 1000; k++) {
+            float32_t x = ot_sin(ot_modulo_2pi(2.0F * PI * 53.0F * Ts * k)) + 0.1F * (k & 1);
+            zassert_within(retuned.calculateWithReturn(x), reference.calculateWithReturn(x), 1e-4F,
+                           "f0 = %f, k = %d", (double)f0, k);
+        }
+        zexpect_equal(retuned.getF0(), f0);
+        zexpect_equal(retuned.getBandwidth(), 10.0F);
+    }
+}
+
+ZTEST(test_filters, test_notchfilter_tracking) {
+    // a sinusoid drifting from 45 to 55 Hz: the notch retuned at each sample stops it
+    const float32_t Ts = 1e-4F;
+    NotchFilter tracking(Ts, 45.0F, 5.0F);
+    NotchFilter fixed(Ts, 45.0F, 5.0F);
+    float32_t angle = 0.0F;
+    float32_t max_tracking = 0.0F, max_fixed = 0.0F;
+    const int steps = 100000;
+    for (int k = 0; k < steps; k++) {
+        float32_t f = 45.0F + 10.0F * k / steps;
+        angle = ot_modulo_2pi(angle + 2.0F * PI * f * Ts);
+        tracking.setF0(f);
+        float32_t y_tracking = tracking.calculateWithReturn(ot_sin(angle));
+        float32_t y_fixed = fixed.calculateWithReturn(ot_sin(angle));
+        if (k > steps / 2) {
+            max_tracking = fmaxf(max_tracking, fabsf(y_tracking));
+            max_fixed = fmaxf(max_fixed, fabsf(y_fixed));
+        }
+    }
+    zexpect_true(max_tracking < 0.02F, "tracking notch leaves %f", (double)max_tracking);
+    zexpect_true(max_fixed > 0.5F, "fixed notch leaves %f", (double)max_fixed);
+}
+
+ZTEST(test_filters, test_constinit_lowpass1st) {
+    #include "datas_test_lowpass1st.h"
+    static constinit LowPassFirstOrderFilter aFilter(1.0, 5.0);
+
+    for (int k=0; k < N_DATAS; k++) {
+        float32_t yfilt = aFilter.calculateWithReturn(yref[k]);
+        zexpect_within(yfilt, y[k], 1e-5, "pb yfilt=%f y[k] = %f, yref[k] = %f", yfilt, y[k], yref[k]);
+    }
+}
+
 ZTEST(test_filters, test_pllangle) {
-    #include "pll_data_test.h"
+    static ot::sim::TestVectorReader<float32_t> capture;
+    zassert_ok(OPEN_CAPTURE(capture, pll_angle));
+    int16_t w = capture.channel("w");
     const float32_t Ts = 100e-6F;
     const float32_t f0 = 50.0F;
     const float32_t w0 = 2.0F * PI * f0;
-    const uint32_t N = 100;
+    const uint32_t N = capture.frames();
     float32_t time;
     float32_t angle = 0.0F;
     PllAngle pll(Ts, f0, 0.02F);
@@ -43,8 +110,118 @@ ZTEST(test_filters, test_pllangle) {
         angle += w0 * Ts;
         angle = ot_modulo_2pi(angle);
         PllDatas result = pll.calculateWithReturn(angle);
-        zexpect_within(w_est[k], result.w, 0.2, "west[k] = %f and result.w = %f", w_est[k], result.w);
+        float32_t w_est = capture.next()[w];
+        zexpect_within(w_est, result.w, 0.2, "west[k] = %f and result.w = %f", w_est, result.w);
+    }
+    capture.close();
+}
+
+ZTEST(test_filters, test_constinit_pllangle) {
+    // built by the compiler, it behaves as the one initialized at run time
+    static constexpr float32_t Ts = 100e-6F;
+    static constexpr float32_t f0 = 50.0F;
+    static constinit PllAngle constant_pll(Ts, f0, 0.02F);
+    PllAngle pll;
+    zassert_ok(pll.init(Ts, f0, 0.02F));
+    constant_pll.reset(0.9F * f0);
+    pll.reset(0.9F * f0);
+    float32_t angle = 0.0F;
+    for (int k = 0; k < 100; k++) {
+        angle = ot_modulo_2pi(angle + 2.0F * PI * f0 * Ts);
+        PllDatas expected = pll.calculateWithReturn(angle);
+        PllDatas result = constant_pll.calculateWithReturn(angle);
+        zexpect_equal(result.w, expected.w, "k = %d", k);
+        zexpect_equal(result.angle, expected.angle, "k = %d", k);
     }
 }
 
 
+
+struct PllSinusStep {
+    float32_t f_error; // of the mean frequency [Hz]
+    float32_t ripple; // of the filtered error
+    float32_t fixed_ripple; // of the error filtered by a notch fixed at 2 f0
+    float32_t difference; // between both filtered errors
+};
+
+/**
+ * @brief a PllSinus on a unit sinusoid at 50 Hz then `f1` from 1 s, over the
+ * last 0.5 s of 3 s.
+ */
+static PllSinusStep pllSinusStep(float32_t f1) {
+    const float32_t Ts = 1e-4F;
+    PllSinus pll(Ts, 1.0F, 50.0F, 0.05F);
+    NotchFilter fixed(Ts, 100.0F, 10.0F);
+    pll.reset(50.0F);
+    PllSinusStep step{};
+    float32_t angle = 0.0F, pll_angle = 0.0F, w_sum = 0.0F;
+    for (int k = 0; k < 30000; k++) {
+        float32_t f = k < 10000 ? 50.0F : f1;
+        angle = ot_modulo_2pi(angle + 2.0F * PI * f * Ts);
+        float32_t signal = ot_sin(angle);
+        // the error the PLL filters, from its angle before the sample
+        float32_t y_fixed = fixed.calculateWithReturn(ot_cos(pll_angle) * signal);
+        PllDatas result = pll.calculateWithReturn(signal);
+        pll_angle = result.angle;
+        if (k >= 25000) {
+            w_sum += result.w;
+            step.ripple = fmaxf(step.ripple, fabsf(result.error));
+            step.fixed_ripple = fmaxf(step.fixed_ripple, fabsf(y_fixed));
+            step.difference = fmaxf(step.difference, fabsf(result.error - y_fixed));
+        }
+    }
+    step.f_error = fabsf(w_sum / 5000.0F / (2.0F * PI) - f1);
+    return step;
+}
+
+ZTEST(test_filters, test_pllsinus_frequency_step) {
+    // the grid steps from 50 to 52 Hz: the PLL locks again and the notch,
+    // moved to 104 Hz, still stops the ripple a notch fixed at 100 Hz lets through
+    PllSinusStep step = pllSinusStep(52.0F);
+    zexpect_true(step.f_error < 0.05F, "locked %f Hz away", (double)step.f_error);
+    zexpect_true(step.ripple < 0.03F, "ripple of %f", (double)step.ripple);
+    zexpect_true(step.fixed_ripple > 0.2F, "fixed notch ripple of %f", (double)step.fixed_ripple);
+}
+
+ZTEST(test_filters, test_pllsinus_nominal) {
+    // at f0 the notch following the frequency filters as the one fixed at 2 f0,
+    // up to the rest of the ripple of w it follows
+    PllSinusStep step = pllSinusStep(50.0F);
+    zexpect_true(step.f_error < 0.05F, "locked %f Hz away", (double)step.f_error);
+    zexpect_true(step.ripple < 1.05F * step.fixed_ripple, "ripple of %f instead of %f", (double)step.ripple,
+                 (double)step.fixed_ripple);
+    zexpect_true(step.difference < 0.25F * step.fixed_ripple, "differs by %f", (double)step.difference);
+}
+
+ZTEST(test_filters, test_notchfilter_reanchoring) {
+    // beyond MAX_DRIFT setF0 takes a new anchor: the series around it, and not
+    // around the first one, give the filters initialized at the new frequency
+    const float32_t Ts = 1e-4F;
+    const float32_t f_drift = NotchFilter::MAX_DRIFT / (2.0F * PI * Ts);
+    const float32_t jumps[][2] = {
+        {50.0F + 2.0F * f_drift, 50.0F + 2.5F * f_drift}, // a jump then within the drift of it
+        {4000.0F, 4000.0F - 0.9F * f_drift}, // w0 = 2.5 rad: the series of the first anchor diverge
+        {4000.0F, 50.0F}, // back beyond the drift
+    };
+    for (const auto &jump : jumps) {
+        NotchFilter retuned(Ts, 50.0F, 5.0F);
+        retuned.setF0(jump[0]);
+        retuned.setF0(jump[1]);
+        NotchFilter reference(Ts, jump[1], 5.0F);
+        for (int k = 0; k < 1000; k++) {
+            float32_t x = ot_sin(ot_modulo_2pi(2.0F * PI * 53.0F * Ts * k)) + 0.1F * (k & 1);
+            zassert_within(retuned.calculateWithReturn(x), reference.calculateWithReturn(x), 1e-4F,
+                           "f0 = %f then %f, k = %d", (double)jump[0], (double)jump[1], k);
+        }
+    }
+    // a slow sweep re-anchors many times without accumulating an error
+    NotchFilter swept(Ts, 50.0F, 5.0F);
+    for (float32_t f = 50.0F; f < 2000.0F; f += 0.5F) {
+        swept.setF0(f);
+    }
+    NotchFilter reference(Ts, 2000.0F - 0.5F, 5.0F);
+    for (int k = 0; k < 1000; k++) {
+        float32_t x = ot_sin(ot_modulo_2pi(2.0F * PI * 53.0F * Ts * k)) + 0.1F * (k & 1);
+        zassert_within(swept.calculateWithReturn(x), reference.calculateWithReturn(x), 1e-4F, "k = %d", k);
+    }
+}
@@ -0,0 +1,81 @@
+#include <math.h>
+#include <zephyr/ztest.h>
+#include <zephyr/logging/log.h>
+#include <harmonics.h>
+#include <filters.h>
+
+LOG_MODULE_DECLARE(test_control);
+
+ZTEST_SUITE(test_harmonics, NULL, NULL, NULL, NULL, NULL);
+
+static const float32_t Ts = 100e-6F;
+static const uint8_t orders[] = {1, 3, 5, 7};
+
+/**
+ * @brief 0.2 + sin(θ) + 0.1 sin(3θ + 0.5) + 0.05 sin(5θ - 1)
+ */
+static float32_t signal(float32_t theta) {
+    return 0.2F + sinf(theta) + 0.1F * sinf(3.0F * theta + 0.5F) + 0.05F * sinf(5.0F * theta - 1.0F);
+}
+
+ZTEST(test_harmonics, test_off_nominal_frequency) {
+    HarmonicAnalyzer analyzer;
+    zassert_equal(analyzer.init(Ts, orders, 4), 0);
+    HarmonicResults results;
+    // 49.3 Hz: 202.8 samples by period
+    const float32_t f = 49.3F;
+    float32_t theta = 1.0F;
+    int periods = 0;
+    for (int k = 0; k < 5000; k++) {
+        analyzer.update(signal(theta), theta);
+        theta = ot_modulo_2pi(theta + 2.0F * PI * f * Ts);
+        if (analyzer.getResults(results)) {
+            periods++;
+            zexpect_within(results.amplitude[0], 1.0F, 1e-2F, "%f", (double)results.amplitude[0]);
+            zexpect_within(results.amplitude[1], 0.1F, 1e-2F);
+            zexpect_within(results.phase[1], 0.5F, 5e-2F);
+            zexpect_within(results.amplitude[2], 0.05F, 1e-2F);
+            zexpect_within(results.phase[2], -1.0F, 0.1F);
+            zexpect_within(results.amplitude[3], 0.0F, 1e-2F);
+            zexpect_within(results.dc, 0.2F, 1e-2F);
+            zexpect_within(results.thd, sqrtf(0.1F * 0.1F + 0.05F * 0.05F), 1e-2F);
+            zexpect_within(results.frequency, f, 0.5F);
+        }
+    }
+    zexpect_true(periods >= 22, "one result by period, the first one being partial: %d", periods);
+    zexpect_true(periods <= 24, "%d", periods);
+}
+
+ZTEST(test_harmonics, test_pll_synchronized) {
+    HarmonicAnalyzer analyzer;
+    zassert_equal(analyzer.init(Ts, orders, 2), 0);
+    // e.g. the angle of a grid voltage given by a dq PLL
+    PllAngle pll(Ts, 50.0F, 0.02F);
+    HarmonicResults results{};
+    const float32_t f = 48.0F;
+    float32_t theta = 0.0F;
+    for (int k = 0; k < 20000; k++) {
+        PllDatas pll_datas = pll.calculateWithReturn(theta);
+        analyzer.update(signal(theta), pll_datas.angle);
+        analyzer.getResults(results);
+        theta = ot_modulo_2pi(theta + 2.0F * PI * f * Ts);
+    }
+    zexpect_within(results.amplitude[0], 1.0F, 2e-2F, "%f", (double)results.amplitude[0]);
+    zexpect_within(results.amplitude[1], 0.1F, 2e-2F, "%f", (double)results.amplitude[1]);
+    zexpect_within(results.frequency, f, 0.5F);
+}
+
+ZTEST(test_harmonics, test_invalid_orders) {
+    HarmonicAnalyzer analyzer;
+    const uint8_t decreasing[] = {3, 1};
+    const uint8_t zero[] = {0, 1};
+    const uint8_t too_high[] = {1, 64};
+    zexpect_equal(analyzer.init(Ts, decreasing, 2), -EINVAL);
+    zexpect_equal(analyzer.init(Ts, zero, 2), -EINVAL);
+    zexpect_equal(analyzer.init(Ts, too_high, 2), -EINVAL);
+    zexpect_equal(analyzer.init(Ts, orders, 0), -EINVAL);
+    zexpect_equal(analyzer.init(0.0F, orders, 4), -EINVAL);
+    HarmonicResults results;
+    zassert_equal(analyzer.init(Ts, orders, 4), 0);
+    zexpect_false(analyzer.getResults(results), "no period yet");
+}
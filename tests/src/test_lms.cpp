@@ -0,0 +1,141 @@
+#include <math.h>
+#include <zephyr/ztest.h>
+#include <zephyr/logging/log.h>
+#include <lms.h>
+#include <trigo.h>
+
+LOG_MODULE_DECLARE(test_control);
+
+ZTEST_SUITE(test_lms, NULL, NULL, NULL, NULL, NULL);
+
+/**
+ * @brief uniform noise in [-amplitude, amplitude] from a linear congruential generator.
+ */
+static float64_t noise(uint32_t &seed, float64_t amplitude) {
+    seed = seed * 1664525U + 1013904223U;
+    return amplitude * ((seed >> 8) * (2.0 / 16777216.0) - 1.0);
+}
+
+ZTEST(test_lms, test_same_as_two_passes) {
+    // the weights updated in the loop of the next output give the textbook LMS
+    const size_t N = 8;
+    const float64_t mu = 0.01, leakage = 0.5;
+    ot::LmsFilter<N, float64_t> lms;
+    zassert_equal(lms.init(ot::LmsParams<float64_t>(mu, leakage)), 0);
+    float64_t w[N] = {}, x[N] = {};
+    uint32_t seed = 1;
+    for (int n = 0; n < 2000; n++) {
+        float64_t input = noise(seed, 1.0);
+        float64_t d = 0.5 * input + 0.2 * x[2] + noise(seed, 0.01);
+        for (size_t k = N - 1; k > 0; k--) {
+            x[k] = x[k - 1];
+        }
+        x[0] = input;
+        float64_t y = 0.0;
+        for (size_t k = 0; k < N; k++) {
+            y += w[k] * x[k];
+        }
+        for (size_t k = 0; k < N; k++) {
+            w[k] = (1.0 - mu * leakage) * w[k] + mu * (d - y) * x[k];
+        }
+        zassert_within(lms.update(input, d), d - y, 1e-12, "n = %d", n);
+    }
+}
+
+ZTEST(test_lms, test_identification) {
+    // NLMS finds an unknown FIR from its input and output
+    const float32_t h[8] = {0.8F, -0.4F, 0.3F, 0.0F, -0.2F, 0.1F, 0.05F, -0.02F};
+    float32_t x[8] = {};
+    ot::NlmsFilter<8, float32_t> nlms;
+    zassert_equal(nlms.init(ot::LmsParams<float32_t>(0.5F)), 0);
+    uint32_t seed = 2;
+    for (int n = 0; n < 2000; n++) {
+        for (int k = 7; k > 0; k--) {
+            x[k] = x[k - 1];
+        }
+        // the step does not depend on the amplitude of the reference
+        x[0] = (float32_t)noise(seed, 100.0);
+        float32_t d = 0.0F;
+        for (int k = 0; k < 8; k++) {
+            d += h[k] * x[k];
+        }
+        nlms.update(x[0], d);
+    }
+    for (int k = 0; k < 8; k++) {
+        zexpect_within(nlms.getWeights()[k], h[k], 1e-3F, "w[%d] = %f", k, (double)nlms.getWeights()[k]);
+    }
+
+    // sign error: slower but converges too
+    ot::NlmsFilter<8, float32_t> sign;
+    zassert_equal(sign.init(ot::LmsParams<float32_t>(0.01F, 0.0F, 1e-6F, true)), 0);
+    for (int n = 0; n < 30000; n++) {
+        for (int k = 7; k > 0; k--) {
+            x[k] = x[k - 1];
+        }
+        x[0] = (float32_t)noise(seed, 1.0);
+        float32_t d = 0.0F;
+        for (int k = 0; k < 8; k++) {
+            d += h[k] * x[k];
+        }
+        sign.update(x[0], d);
+    }
+    for (int k = 0; k < 8; k++) {
+        zexpect_within(sign.getWeights()[k], h[k], 3e-2F, "w[%d] = %f", k, (double)sign.getWeights()[k]);
+    }
+}
+
+ZTEST(test_lms, test_ripple_cancellation) {
+    // a ripple whose frequency drifts from 50 to 60 Hz, the reference is the
+    // sin and cos of its angle, e.g. given by a PLL
+    const float32_t Ts = 100e-6F;
+    ot::NlmsFilter<2, float32_t> nlms;
+    zassert_equal(nlms.init(ot::LmsParams<float32_t>(0.01F)), 0);
+    float32_t angle = 0.0F;
+    float32_t max_error = 0.0F;
+    const int steps = 20000;
+    for (int n = 0; n < steps; n++) {
+        float32_t f = 50.0F + 10.0F * n / steps;
+        angle = ot_modulo_2pi(angle + 2.0F * PI * f * Ts);
+        float32_t measure = 1.0F + 2.0F * ot_sin(angle + 0.5F);
+        float32_t e = nlms.update({ot_sin(angle), ot_cos(angle)}, measure);
+        if (n > 2000) {
+            max_error = fmaxf(max_error, fabsf(e - 1.0F));
+        }
+    }
+    zexpect_true(max_error < 0.05F, "ripple left %f", (double)max_error);
+    // the estimate is the ripple
+    zexpect_within(nlms.getEstimate(), 2.0F * ot_sin(angle + 0.5F), 0.05F);
+}
+
+ZTEST(test_lms, test_leakage) {
+    ot::LmsFilter<2, float32_t> lms, leaky;
+    zassert_equal(lms.init(ot::LmsParams<float32_t>(0.1F)), 0);
+    zassert_equal(leaky.init(ot::LmsParams<float32_t>(0.1F, 0.01F)), 0);
+    for (int n = 0; n < 1000; n++) {
+        lms.update({1.0F, 0.0F}, 1.0F);
+        leaky.update({1.0F, 0.0F}, 1.0F);
+    }
+    zexpect_within(lms.getWeights()[0], 1.0F, 1e-4F);
+    // biased by the leakage: w = 1 / (1 + leakage)
+    zexpect_within(leaky.getWeights()[0], 1.0F / 1.01F, 1e-4F);
+    // without excitation, the leaky weights are forgotten
+    for (int n = 0; n < 10000; n++) {
+        lms.update({0.0F, 0.0F}, 0.0F);
+        leaky.update({0.0F, 0.0F}, 0.0F);
+    }
+    zexpect_within(lms.getWeights()[0], 1.0F, 1e-4F);
+    zexpect_within(leaky.getWeights()[0], 0.0F, 1e-3F);
+
+    leaky.reset();
+    zexpect_equal(leaky.getWeights()[0], 0.0F);
+}
+
+ZTEST(test_lms, test_invalid_params) {
+    ot::LmsFilter<4, float32_t> lms;
+    ot::NlmsFilter<4, float32_t> nlms;
+    zexpect_equal(lms.init(ot::LmsParams<float32_t>(0.0F)), -EINVAL);
+    zexpect_equal(lms.init(ot::LmsParams<float32_t>(0.1F, 10.0F)), -EINVAL);
+    zexpect_equal(lms.init(ot::LmsParams<float32_t>(3.0F)), 0);
+    zexpect_equal(nlms.init(ot::LmsParams<float32_t>(3.0F)), -EINVAL);
+    zexpect_equal(nlms.setParams(ot::LmsParams<float32_t>(0.1F, 0.0F, -1.0F)), -EINVAL);
+}
@@ -0,0 +1,71 @@
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <mailbox.h>
+#include <transform.h>
+#include <pid.h>
+
+LOG_MODULE_DECLARE(test_control);
+
+ZTEST_SUITE(test_mailbox, NULL, NULL, NULL, NULL, NULL);
+
+#define MAILBOX_STACK_SIZE 1024
+#define MAILBOX_VERSIONS 50000
+
+static ot::Mailbox<dqo_t> mailbox;
+static std::atomic<bool> mailbox_done;
+K_THREAD_STACK_DEFINE(mailbox_stack, MAILBOX_STACK_SIZE);
+static struct k_thread mailbox_thread;
+
+/* supervisory thread: posts references with all fields equal. */
+static void mailbox_writer(void *, void *, void *) {
+    for (uint32_t version = 1; version <= MAILBOX_VERSIONS; version++) {
+        float32_t v = (float32_t)version;
+        mailbox.post(dqo_t(v, v, v));
+    }
+    mailbox_done = true;
+}
+
+ZTEST(test_mailbox, test_no_torn_reference) {
+    mailbox_done = false;
+    k_thread_create(&mailbox_thread, mailbox_stack, K_THREAD_STACK_SIZEOF(mailbox_stack),
+                    mailbox_writer, NULL, NULL, NULL,
+                    K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+    dqo_t reference(0.0F, 0.0F, 0.0F);
+    uint32_t torn = 0;
+    uint32_t backward = 0;
+    while (!mailbox_done) {
+        float32_t previous = reference.d;
+        mailbox.take(reference);
+        if (reference.d != reference.q || reference.d != reference.o) {
+            torn++;
+        }
+        if (reference.d < previous) {
+            backward++;
+        }
+        k_yield();
+    }
+    k_thread_join(&mailbox_thread, K_FOREVER);
+    mailbox.take(reference);
+    zassert_equal(torn, 0, "%u torn references", torn);
+    zassert_equal(backward, 0, "%u references read backward", backward);
+    zassert_equal(reference.d, (float32_t)MAILBOX_VERSIONS);
+}
+
+#ifdef CONTROL_LIB_MAILBOX
+ZTEST(test_mailbox, test_pid_receive) {
+    Pid pid(PidParams(100e-6F, 2.0F, 1e6F, 0.0F, 1.0F, -10.0F, 10.0F));
+    pid.setReference(1.0F);
+    pid.setMeasurement(0.0F);
+    /* nothing posted: the values set directly are kept. */
+    pid.receive();
+    pid.calculate();
+    zexpect_within(pid.getOutput(), 2.0F, 1e-6F);
+    pid.postReference(3.0F);
+    pid.postMeasurement(2.5F);
+    pid.postReference(2.0F);
+    pid.receive();
+    pid.calculate();
+    zexpect_within(pid.getOutput(), -1.0F, 1e-6F, "only the last value posted is taken");
+}
+#endif
@@ -0,0 +1,114 @@
+#include <math.h>
+#include <zephyr/ztest.h>
+#include <zephyr/logging/log.h>
+#include <mpc.h>
+
+LOG_MODULE_DECLARE(test_control);
+
+ZTEST_SUITE(test_mpc, NULL, NULL, NULL, NULL, NULL);
+
+static const float32_t Ts = 20e-6F;
+static const float32_t R = 0.5F;
+static const float32_t L = 10e-3F;
+static const float32_t Vdc = 400.0F;
+static const float32_t w = 2.0F * PI * 50.0F;
+static const float32_t I = 10.0F;
+
+/**
+ * @brief simulate the inverter and its R-L load, the switching state decided at
+ * k being applied at k+1 when `delayed`.
+ *
+ * @return rms of the current error in the α, β frame.
+ */
+static float32_t run(FcsMpc &mpc, bool delayed) {
+    const int steps = 10000;
+    clarke_t current{};
+    uint8_t applied = 0;
+    float32_t a = expf(-R * Ts / L);
+    float32_t b = (1.0F - a) / R;
+    float32_t error = 0.0F;
+    for (int k = 0; k < steps; k++) {
+        // reference of the next sample, where the prediction is done
+        int ahead = delayed ? 2 : 1;
+        clarke_t reference{I * cosf(w * Ts * (k + ahead)), I * sinf(w * Ts * (k + ahead)), 0.0F};
+        FcsMpcMeasure measure{Transform::clarke_inverse(current), clarke_t{}};
+        uint8_t state = mpc.calculateWithReturn(reference, measure);
+        if (!delayed) {
+            applied = state;
+        }
+        clarke_t v = mpc.getVoltage(applied);
+        current.alpha = a * current.alpha + b * v.alpha;
+        current.beta = b * v.beta + a * current.beta;
+        if (delayed) {
+            applied = state;
+        }
+        if (k >= steps / 2) {
+            float32_t ea = I * cosf(w * Ts * (k + 1)) - current.alpha;
+            float32_t eb = I * sinf(w * Ts * (k + 1)) - current.beta;
+            error += ea * ea + eb * eb;
+        }
+    }
+    return sqrtf(error / (steps / 2));
+}
+
+ZTEST(test_mpc, test_voltages) {
+    FcsMpc mpc;
+    zassert_equal(mpc.init(FcsMpcParams{Ts, R, L, Vdc, 0.0F, false}), 0);
+    zexpect_within(mpc.getVoltage(0).alpha, 0.0F, 1e-3F);
+    zexpect_within(mpc.getVoltage(7).beta, 0.0F, 1e-3F);
+    for (uint8_t state = 1; state < 7; state++) {
+        clarke_t v = mpc.getVoltage(state);
+        zexpect_within(sqrtf(v.alpha * v.alpha + v.beta * v.beta), 2.0F / 3.0F * Vdc, 1e-2F,
+                       "active vectors have an amplitude of 2/3 Vdc");
+    }
+    zexpect_within(mpc.getVoltage(1).alpha, 2.0F / 3.0F * Vdc, 1e-2F);
+    zexpect_within(mpc.getVoltage(1).beta, 0.0F, 1e-2F);
+}
+
+ZTEST(test_mpc, test_tracking) {
+    FcsMpc mpc;
+    zassert_equal(mpc.init(FcsMpcParams{Ts, R, L, Vdc, 0.0F, false}), 0);
+    float32_t error = run(mpc, false);
+    zexpect_true(error < 0.05F * I, "rms error %f", (double)error);
+}
+
+ZTEST(test_mpc, test_delay_compensation) {
+    FcsMpc naive;
+    zassert_equal(naive.init(FcsMpcParams{Ts, R, L, Vdc, 0.0F, false}), 0);
+    FcsMpc compensated;
+    zassert_equal(compensated.init(FcsMpcParams{Ts, R, L, Vdc, 0.0F, true}), 0);
+    float32_t naive_error = run(naive, true);
+    float32_t compensated_error = run(compensated, true);
+    zexpect_true(compensated_error < naive_error, "%f >= %f",
+                 (double)compensated_error, (double)naive_error);
+    zexpect_true(compensated_error < 0.05F * I, "rms error %f", (double)compensated_error);
+}
+
+ZTEST(test_mpc, test_switching_penalty) {
+    FcsMpc mpc;
+    // small reference: the cost of a commutation is higher than the error
+    zassert_equal(mpc.init(FcsMpcParams{Ts, R, L, Vdc, 1e6F, false}), 0);
+    FcsMpcMeasure measure{};
+    zexpect_equal(mpc.calculateWithReturn(clarke_t{0.1F, 0.0F, 0.0F}, measure), 0);
+    mpc.init(FcsMpcParams{Ts, R, L, Vdc, 0.0F, false});
+    zexpect_equal(mpc.calculateWithReturn(clarke_t{I, 0.0F, 0.0F}, measure), 1,
+                  "the vector of the leg a is the closest to the reference");
+}
+
+ZTEST(test_mpc, test_invalid_params) {
+    FcsMpc mpc;
+    zexpect_equal(mpc.init(FcsMpcParams{0.0F, R, L, Vdc, 0.0F, false}), -EINVAL);
+    zexpect_equal(mpc.init(FcsMpcParams{Ts, R, 0.0F, Vdc, 0.0F, false}), -EINVAL);
+    zexpect_equal(mpc.init(FcsMpcParams{Ts, R, L, Vdc, -1.0F, false}), -EINVAL);
+}
+
+#if defined(CONTROL_LIB_CYCLES) && !defined(CONTROL_LIB_CYCLES_DWT)
+ZTEST(test_mpc, test_budget) {
+    FcsMpc mpc;
+    zassert_equal(mpc.init(FcsMpcParams{Ts, R, L, Vdc, 0.0F, true}), 0);
+    run(mpc, true);
+    // durations are in ns on native_posix and on the host
+    zexpect_true(mpc.getCycleStats().getMean() < 50000, "mean %u ns",
+                 mpc.getCycleStats().getMean());
+}
+#endif
@@ -0,0 +1,163 @@
+#include <math.h>
+#include <zephyr/ztest.h>
+#include <zephyr/logging/log.h>
+#include <observer.h>
+#include <filters.h>
+
+LOG_MODULE_DECLARE(test_control);
+
+ZTEST_SUITE(test_observer, NULL, NULL, NULL, NULL, NULL);
+
+typedef ot::Observer<1, 1, 1, float32_t> ScalarObserver;
+typedef ot::Observer<2, 1, 1, float32_t> LcObserver;
+
+/**
+ * @brief uniform noise in [-amplitude, amplitude] from a linear congruential generator.
+ */
+static float32_t noise(uint32_t &seed, float32_t amplitude) {
+    seed = seed * 1664525U + 1013904223U;
+    return amplitude * ((seed >> 8) * (2.0F / 16777216.0F) - 1.0F);
+}
+
+/**
+ * @brief LC filter discretized with Ts = 50 µs (semi implicit Euler, the voltage
+ * uses the new current): the states are the inductor current and the capacitor
+ * voltage, the voltage is measured.
+ */
+static constexpr float32_t Ts = 50e-6F;
+static constexpr float32_t L = 1e-3F;
+static constexpr float32_t C = 10e-6F;
+static constexpr float32_t R = 0.1F;
+
+static constexpr LcObserver::Model lcModel(void) {
+    LcObserver::Model m{};
+    m.Ts = Ts;
+    m.A[0][0] = 1.0F - R * Ts / L;
+    m.A[0][1] = -Ts / L;
+    m.B[0][0] = Ts / L;
+    m.A[1][0] = Ts / C * m.A[0][0];
+    m.A[1][1] = 1.0F + Ts / C * m.A[0][1];
+    m.B[1][0] = Ts / C * m.B[0][0];
+    m.C[0][1] = 1.0F;
+    m.Q[0][0] = 1e-4F;
+    m.Q[1][1] = 1e-4F;
+    m.R[0][0] = 4.0F / 3.0F;
+    return m;
+}
+
+ZTEST(test_observer, test_scalar_gain) {
+    // random walk: the steady state predicted covariance is (q + sqrt(q² + 4 q r)) / 2
+    ScalarObserver::Model m{};
+    m.Ts = 1.0F;
+    m.A[0][0] = 1.0F;
+    m.C[0][0] = 1.0F;
+    m.Q[0][0] = 1.0F;
+    m.R[0][0] = 1.0F;
+    ScalarObserver observer;
+    zassert_equal(observer.init(m), 0);
+    float32_t P = (1.0F + sqrtf(5.0F)) / 2.0F;
+    zexpect_within(observer.getGain().K[0][0], P / (P + 1.0F), 1e-4F);
+}
+
+ZTEST(test_observer, test_compile_time_gain) {
+    static constexpr LcObserver::Model model = lcModel();
+    constexpr LcObserver::Gain gain = LcObserver::kalmanGain(model);
+    LcObserver observer;
+    zassert_equal(observer.init(model), 0);
+    zexpect_within(observer.getGain().K[0][0], gain.K[0][0], 1e-4F);
+    zexpect_within(observer.getGain().K[1][0], gain.K[1][0], 1e-4F);
+}
+
+ZTEST(test_observer, test_lc_estimation) {
+    static constexpr LcObserver::Model model = lcModel();
+    LcObserver observer;
+    zassert_equal(observer.init(model), 0);
+    LowPassFirstOrderFilter lowpass(Ts, 1e-3F);
+    uint32_t seed = 1;
+    float32_t current = 0.0F, voltage = 0.0F;
+    float32_t u = 0.0F;
+    float32_t observer_error = 0.0F, lowpass_error = 0.0F, measure_error = 0.0F;
+    const int steps = 20000;
+    for (int k = 0; k < steps; k++) {
+        float32_t y = voltage + noise(seed, 2.0F);
+        const LcObserver::State &x = observer.update({u}, {y});
+        float32_t filtered = lowpass.calculateWithReturn(y);
+        if (k >= steps / 2) {
+            observer_error += (x[1] - voltage) * (x[1] - voltage);
+            lowpass_error += (filtered - voltage) * (filtered - voltage);
+            measure_error += (y - voltage) * (y - voltage);
+        }
+        // 50 Hz sinus input and the plant
+        u = 100.0F * sinf(2.0F * PI * 50.0F * Ts * k);
+        float32_t next_current = model.A[0][0] * current + model.A[0][1] * voltage + model.B[0][0] * u;
+        voltage = model.A[1][0] * current + model.A[1][1] * voltage + model.B[1][0] * u;
+        current = next_current;
+    }
+    zexpect_true(observer_error < 0.25F * measure_error, "%f %f",
+                 (double)observer_error, (double)measure_error);
+    zexpect_true(observer_error < lowpass_error, "no lag: %f %f",
+                 (double)observer_error, (double)lowpass_error);
+}
+
+ZTEST(test_observer, test_luenberger) {
+    // x(k+1) = 0.5 x + u, y = x: the gain 1 gives the measure
+    ScalarObserver::Model m{};
+    m.Ts = 1.0F;
+    m.A[0][0] = 0.5F;
+    m.B[0][0] = 1.0F;
+    m.C[0][0] = 1.0F;
+    ScalarObserver observer;
+    ScalarObserver::Gain gain{};
+    gain.K[0][0] = 1.0F;
+    zassert_equal(observer.init(m, gain), 0);
+    zexpect_within(observer.update({2.0F}, {3.0F})[0], 3.0F, 1e-6F);
+    gain.K[0][0] = 0.0F;
+    zassert_equal(observer.init(m, gain), 0);
+    observer.setState({2.0F});
+    zexpect_within(observer.update({2.0F}, {3.0F})[0], 3.0F, 1e-6F, "open loop prediction");
+}
+
+ZTEST(test_observer, test_invalid_model) {
+    ScalarObserver::Model m{};
+    m.Ts = 1.0F;
+    m.A[0][0] = 1.0F;
+    m.C[0][0] = 1.0F;
+    ScalarObserver observer;
+    zexpect_equal(observer.init(m), -EINVAL, "R = 0 and Q = 0: C P C' + R is singular");
+    m.A[0][0] = 2.0F;
+    m.C[0][0] = 0.0F;
+    m.Q[0][0] = 1.0F;
+    m.R[0][0] = 1.0F;
+    zexpect_equal(observer.init(m), -EINVAL, "unstable and not observable");
+    m.A[0][0] = 1.0F;
+    zexpect_equal(observer.init(m), -EINVAL, "P grows without bound: stops at MAX_ITERATIONS");
+    zexpect_equal(ScalarObserver::kalmanGain(m).K[0][0], 0.0F);
+}
+
+ZTEST(test_observer, test_float32_convergence) {
+    // Q << R: P converges slowly, by updates under the resolution of a float32_t
+    typedef ot::Observer<2, 1, 1, float64_t> WideObserver;
+    LcObserver::Model m = lcModel();
+    WideObserver::Model wide{};
+    m.Q[0][0] = m.Q[1][1] = 1e-8F;
+    m.R[0][0] = 100.0F;
+    wide.Ts = m.Ts;
+    for (int i = 0; i < 2; i++) {
+        for (int j = 0; j < 2; j++) {
+            wide.A[i][j] = m.A[i][j];
+            wide.Q[i][j] = m.Q[i][j];
+        }
+        wide.B[i][0] = m.B[i][0];
+        wide.C[0][i] = m.C[0][i];
+    }
+    wide.R[0][0] = m.R[0][0];
+    LcObserver observer;
+    WideObserver reference;
+    zassert_equal(observer.init(m), 0);
+    zassert_equal(reference.init(wide), 0);
+    for (int i = 0; i < 2; i++) {
+        float64_t K = reference.getGain().K[i][0];
+        zexpect_within(observer.getGain().K[i][0], K, 1e-5 * K, "K[%d] = %g instead of %g", i,
+                       (double)observer.getGain().K[i][0], K);
+    }
+}
@@ -0,0 +1,63 @@
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <recorder.h>
+#include <pid.h>
+
+LOG_MODULE_DECLARE(test_control);
+
+ZTEST_SUITE(test_recorder, NULL, NULL, NULL, NULL, NULL);
+
+ZTEST(test_recorder, test_ring_buffer) {
+    static ot::RecordSample<float32_t> buffer[8];
+    ot::Recorder<ot::RecordSample<float32_t>> recorder;
+    zexpect_equal(recorder.init(buffer, 6), -EINVAL);
+    zassert_equal(recorder.init(buffer, 8), 0);
+    for (int k = 0; k < 10; k++) {
+        recorder.push({(float32_t)k, 0.0F, 0.0F, 0});
+    }
+    zexpect_equal(recorder.getDropped(), 2);
+    float32_t expected = 0.0F;
+    uint32_t count = recorder.drain([&](const ot::RecordSample<float32_t> *samples, uint32_t n) {
+        for (uint32_t k = 0; k < n; k++) {
+            zexpect_equal(samples[k].reference, expected);
+            expected += 1.0F;
+        }
+    });
+    zexpect_equal(count, 8);
+    for (int k = 0; k < 3; k++) {
+        recorder.push({(float32_t)k, 0.0F, 0.0F, 0});
+    }
+    zexpect_equal(recorder.drain([](const ot::RecordSample<float32_t> *, uint32_t) {}), 3);
+    /* wrap around: the samples are given in two blocks */
+    for (int k = 0; k < 7; k++) {
+        recorder.push({(float32_t)k, 0.0F, 0.0F, 0});
+    }
+    uint32_t blocks = 0;
+    count = recorder.drain([&](const ot::RecordSample<float32_t> *, uint32_t) { blocks++; });
+    zexpect_equal(count, 7);
+    zexpect_equal(blocks, 2);
+    zexpect_equal(recorder.drain([](const ot::RecordSample<float32_t> *, uint32_t) {}), 0);
+}
+
+#ifdef CONTROL_LIB_RECORDER
+ZTEST(test_recorder, test_pid_record) {
+    static ot::RecordSample<float32_t> buffer[16];
+    ot::Recorder<ot::RecordSample<float32_t>> recorder;
+    recorder.init(buffer, 16);
+    Pid pid(PidParams(100e-6F, 1.0F, 1e-3F, 0.0F, 1.0F, -1.0F, 1.0F));
+    pid.setRecorder(&recorder);
+    pid.calculateWithReturn(0.5F, 0.0F);
+    pid.calculateWithReturn(5.0F, 0.0F);
+    uint32_t k = 0;
+    recorder.drain([&](const ot::RecordSample<float32_t> *samples, uint32_t n) {
+        zassert_equal(n, 2);
+        zexpect_equal(samples[0].reference, 0.5F);
+        zexpect_equal(samples[0].saturated, 0);
+        zexpect_equal(samples[1].output, 1.0F);
+        zexpect_equal(samples[1].saturated, 1);
+        k += n;
+    });
+    zexpect_equal(k, 2);
+}
+#endif
@@ -0,0 +1,108 @@
+#include <math.h>
+#include <zephyr/ztest.h>
+#include <zephyr/logging/log.h>
+#include <repetitive.h>
+
+LOG_MODULE_DECLARE(test_control);
+
+ZTEST_SUITE(test_repetitive, NULL, NULL, NULL, NULL, NULL);
+
+static const ot_scalar_t Ts = 100e-6F;
+static ot_scalar_t period[512];
+
+/**
+ * @brief first order plant y(k+1) = 0.9 y(k) + 0.1 (u(k) + d(k)) with a
+ * disturbance d made of the harmonics 1, 3, 5 and 7 of f0.
+ */
+struct Plant {
+    ot_scalar_t y = 0.0F;
+    ot_scalar_t angle = 0.0F;
+
+    ot_scalar_t step(ot_scalar_t u, ot_scalar_t f0) {
+        ot_scalar_t d = sinf(angle) + 0.5F * sinf(3.0F * angle) + 0.3F * sinf(5.0F * angle)
+                    + 0.2F * sinf(7.0F * angle);
+        angle += 2.0F * PI * f0 * Ts;
+        angle = angle > 2.0F * PI ? angle - 2.0F * PI : angle;
+        y = 0.9F * y + 0.1F * (u + d);
+        return y;
+    };
+};
+
+/**
+ * @return rms of the error during the last period of `steps`.
+ */
+static ot_scalar_t run(Repetitive &controller, Plant &plant, int steps, ot_scalar_t f0) {
+    ot_scalar_t error = 0.0F;
+    int last = (int)(1.0F / (f0 * Ts));
+    for (int k = 0; k < steps; k++) {
+        ot_scalar_t u = controller.calculateWithReturn(0.0F, plant.y);
+        plant.step(u, f0);
+        if (k >= steps - last) {
+            error += plant.y * plant.y;
+        }
+    }
+    return sqrtf(error / last);
+}
+
+static RepetitiveParams params(ot_scalar_t f0, ot_scalar_t Kr) {
+    return RepetitiveParams{Ts, 1.0F, Kr, 2.0F * PI * f0, 0.1F, 1, -10.0F, 10.0F, period, 512};
+}
+
+ZTEST(test_repetitive, test_rejection) {
+    Repetitive proportional;
+    zassert_equal(proportional.init(params(50.0F, 1e-6F)), 0);
+    Plant plant_p;
+    ot_scalar_t error_p = run(proportional, plant_p, 20000, 50.0F);
+
+    Repetitive repetitive;
+    zassert_equal(repetitive.init(params(50.0F, 0.5F)), 0);
+    Plant plant_r;
+    ot_scalar_t error_r = run(repetitive, plant_r, 20000, 50.0F);
+    zexpect_true(error_r < 0.01F * error_p, "%f %f", (double)error_r, (double)error_p);
+}
+
+ZTEST(test_repetitive, test_fractional_period) {
+    // 10 kHz / 49.3 Hz = 202.8 samples
+    Repetitive repetitive;
+    zassert_equal(repetitive.init(params(50.0F, 0.5F)), 0);
+    Plant plant;
+    run(repetitive, plant, 20000, 50.0F);
+    ot_scalar_t detuned = run(repetitive, plant, 4000, 49.3F);
+    zassert_equal(repetitive.setW0(2.0F * PI * 49.3F), 0);
+    ot_scalar_t tracked = run(repetitive, plant, 20000, 49.3F);
+    zexpect_true(tracked < 0.2F * detuned, "%f %f", (double)tracked, (double)detuned);
+}
+
+ZTEST(test_repetitive, test_saturation) {
+    Repetitive repetitive;
+    RepetitiveParams p = params(50.0F, 0.5F);
+    p.lower_bound = -0.5F;
+    p.upper_bound = 0.5F;
+    zassert_equal(repetitive.init(p), 0);
+    Plant plant;
+    for (int k = 0; k < 20000; k++) {
+        ot_scalar_t u = repetitive.calculateWithReturn(0.0F, plant.y);
+        zassert_true(u >= -0.5F && u <= 0.5F);
+        zassert_true(fabsf(repetitive.getRepetitive()) <= 0.5F,
+                     "the learned signal does not wind up");
+        plant.step(u, 50.0F);
+    }
+    // the bounds of the base controller follow the new ones
+    repetitive.setBounds(-0.2F, 0.3F);
+    zexpect_equal(repetitive.saturate(10.0F), 0.3F);
+    zexpect_equal(repetitive.saturate(-10.0F), -0.2F);
+}
+
+ZTEST(test_repetitive, test_invalid_params) {
+    Repetitive repetitive;
+    RepetitiveParams p = params(50.0F, 0.5F);
+    p.capacity = 200;
+    zexpect_equal(repetitive.init(p), -EINVAL, "the period does not fit");
+    p = params(50.0F, 2.5F);
+    zexpect_equal(repetitive.init(p), -EINVAL);
+    p = params(50.0F, 0.5F);
+    p.buffer = nullptr;
+    zexpect_equal(repetitive.init(p), -EINVAL);
+    zassert_equal(repetitive.init(params(50.0F, 0.5F)), 0);
+    zexpect_equal(repetitive.setW0(2.0F * PI * 10.0F), -EINVAL, "1000 samples");
+}
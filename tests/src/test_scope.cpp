@@ -0,0 +1,101 @@
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <scope.h>
+#include <pid.h>
+#include <filters.h>
+
+LOG_MODULE_DECLARE(test_control);
+
+ZTEST_SUITE(test_scope, NULL, NULL, NULL, NULL, NULL);
+
+static ot_scalar_t scope_buffer[64];
+
+ZTEST(test_scope, test_rising_edge) {
+    ot::Scope<ot_scalar_t> scope;
+    ot_scalar_t ramp = 0.0F;
+    ot_scalar_t square = 0.0F;
+    zassert_equal(scope.init(scope_buffer, 64), 0);
+    zassert_equal(scope.addChannel(&ramp), 0);
+    zassert_equal(scope.addChannel(&square), 1);
+    zexpect_equal(scope.getDepth(), 32);
+    zexpect_equal(scope.setTrigger(2, ot::Scope<ot_scalar_t>::LEVEL, 0.0F), -EINVAL);
+    zassert_equal(scope.setTrigger(1, ot::Scope<ot_scalar_t>::RISING_EDGE, 0.5F), 0);
+    zexpect_equal(scope.arm(32), -EINVAL);
+    zassert_equal(scope.arm(8), 0);
+    zexpect_equal(scope.addChannel(&ramp), -EBUSY);
+    for (int k = 0; k < 200; k++) {
+        ramp = k;
+        square = ((k / 50) & 1) ? 1.0F : 0.0F;
+        scope.sample();
+    }
+    zassert_equal(scope.getState(), ot::Scope<ot_scalar_t>::FROZEN);
+    /* first rising edge at k = 50, 8 samples before it */
+    for (uint32_t k = 0; k < 32; k++) {
+        zexpect_equal(scope.read(k, 0), 42.0F + k, "k = %u", k);
+    }
+    zexpect_equal(scope.read(7, 1), 0.0F);
+    zexpect_equal(scope.read(8, 1), 1.0F);
+}
+
+ZTEST(test_scope, test_decimation_and_force) {
+    ot::Scope<ot_scalar_t> scope;
+    ot_scalar_t counter = 0.0F;
+    scope.init(scope_buffer, 16);
+    scope.addChannel(&counter);
+    scope.setTrigger(0, ot::Scope<ot_scalar_t>::LEVEL, 1e9F);
+    zassert_equal(scope.arm(4, 3), 0);
+    for (int k = 0; k < 100; k++) {
+        counter = k;
+        scope.sample();
+    }
+    zexpect_equal(scope.getState(), ot::Scope<ot_scalar_t>::ARMED);
+    scope.forceTrigger();
+    for (int k = 100; k < 200; k++) {
+        counter = k;
+        scope.sample();
+    }
+    zassert_equal(scope.getState(), ot::Scope<ot_scalar_t>::FROZEN);
+    for (uint32_t k = 1; k < 16; k++) {
+        zexpect_equal(scope.read(k, 0) - scope.read(k - 1, 0), 3.0F);
+    }
+}
+
+ZTEST(test_scope, test_pid_saturation) {
+    ot::Scope<ot_scalar_t> scope;
+    Pid pid(PidParams(100e-6F, 1.0F, 1e-3F, 0.0F, 1.0F, -1.0F, 1.0F));
+    ot_scalar_t output = 0.0F;
+    scope.init(scope_buffer, 48);
+    scope.addChannel(&output);
+    scope.addChannel(&pid.getIntegral());
+    scope.addChannel(&pid.getFilteredDerivative());
+    scope.setTrigger(0, ot::Scope<ot_scalar_t>::SATURATION, 1.0F, -1.0F);
+    scope.arm(4);
+    for (int k = 0; k < 100; k++) {
+        output = pid.calculateWithReturn(0.1F * k, 0.0F);
+        scope.sample();
+    }
+    zassert_equal(scope.getState(), ot::Scope<ot_scalar_t>::FROZEN);
+    zexpect_true(scope.read(3, 0) < 1.0F);
+    zexpect_equal(scope.read(4, 0), 1.0F);
+    zexpect_true(scope.read(4, 1) > 0.0F, "integral = %f", scope.read(4, 1));
+}
+
+ZTEST(test_scope, test_pll_signals) {
+    ot::Scope<ot_scalar_t> scope;
+    PllAngle pll(100e-6F, 50.0F, 0.02F);
+    scope.init(scope_buffer, 64);
+    scope.addChannel(&pll.getW());
+    scope.addChannel(&pll.getAngle());
+    scope.setTrigger(1, ot::Scope<ot_scalar_t>::FALLING_EDGE, 1.0F);
+    scope.arm(16);
+    ot_scalar_t angle = 0.0F;
+    for (int k = 0; k < 1000; k++) {
+        angle = ot_modulo_2pi(angle + 2.0F * PI * 50.0F * 100e-6F);
+        pll.calculateWithReturn(angle);
+        scope.sample();
+    }
+    zassert_equal(scope.getState(), ot::Scope<ot_scalar_t>::FROZEN);
+    zexpect_true(scope.read(16, 1) <= 1.0F);
+    zexpect_true(scope.read(15, 1) > 1.0F);
+}
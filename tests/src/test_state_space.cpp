@@ -0,0 +1,121 @@
+#include <zephyr/ztest.h>
+#include <zephyr/logging/log.h>
+#include <state_space.h>
+
+LOG_MODULE_DECLARE(test_control);
+
+ZTEST_SUITE(test_state_space, NULL, NULL, NULL, NULL, NULL);
+
+typedef ot::StateSpace<1, 1, 1, float32_t> Siso;
+typedef ot::StateSpace<2, 1, 1, float32_t> Observer;
+
+/**
+ * @brief PI controller: x(k+1) = x + Ts Ki e, u = x + Kp e, e = r - y
+ */
+static ot::StateSpaceParams<1, 1, 1, float32_t> piParams(float32_t Ts, float32_t Kp, float32_t Ki) {
+    ot::StateSpaceParams<1, 1, 1, float32_t> p{};
+    p.Ts = Ts;
+    p.A[0][0] = 1.0F;
+    p.Br[0][0] = Ts * Ki;
+    p.By[0][0] = -Ts * Ki;
+    p.C[0][0] = 1.0F;
+    p.Dr[0][0] = Kp;
+    p.Dy[0][0] = -Kp;
+    p.lower_bound = {-10.0F};
+    p.upper_bound = {10.0F};
+    return p;
+}
+
+/**
+ * @brief deadbeat state feedback and observer of the double integrator
+ * x1(k+1) = x1 + x2 + u / 2, x2(k+1) = x2 + u, y = x1, with Ts = 1.
+ *
+ * K = [1, 1.5], L = [2, 1]: the controller states follow
+ * x(k+1) = (A - L C) x + L y + B u, u = -K x + r.
+ */
+static ot::StateSpaceParams<2, 1, 1, float32_t> observerParams(float32_t bound) {
+    ot::StateSpaceParams<2, 1, 1, float32_t> p{};
+    p.Ts = 1.0F;
+    p.A[0][0] = -1.0F;
+    p.A[0][1] = 1.0F;
+    p.A[1][0] = -1.0F;
+    p.A[1][1] = 1.0F;
+    p.By[0][0] = 2.0F;
+    p.By[1][0] = 1.0F;
+    p.Bu[0][0] = 0.5F;
+    p.Bu[1][0] = 1.0F;
+    p.C[0][0] = -1.0F;
+    p.C[0][1] = -1.5F;
+    p.Dr[0][0] = 1.0F;
+    p.lower_bound = {-bound};
+    p.upper_bound = {bound};
+    return p;
+}
+
+ZTEST(test_state_space, test_pi) {
+    Siso pi;
+    const float32_t Ts = 1e-3F, Kp = 2.0F, Ki = 50.0F;
+    zassert_equal(pi.init(piParams(Ts, Kp, Ki)), 0);
+    float32_t integral = 0.0F;
+    for (int k = 0; k < 20; k++) {
+        float32_t y = 0.1F * k;
+        float32_t e = 1.0F - y;
+        float32_t expected = integral + Kp * e;
+        zexpect_within(pi.calculateWithReturn({1.0F}, {y})[0], expected, 1e-5F, "k = %d", k);
+        integral += Ts * Ki * e;
+    }
+}
+
+ZTEST(test_state_space, test_observer_based_control) {
+    Observer controller;
+    zassert_equal(controller.init(observerParams(100.0F)), 0);
+    float32_t x1 = 0.3F, x2 = -0.2F;
+    for (int k = 0; k < 8; k++) {
+        float32_t u = controller.calculateWithReturn({1.0F}, {x1})[0];
+        x1 = x1 + x2 + 0.5F * u;
+        x2 = x2 + u;
+        if (k >= 4) {
+            zexpect_within(x1, 1.0F, 1e-4F, "k = %d", k);
+            zexpect_within(x2, 0.0F, 1e-4F, "k = %d", k);
+        }
+    }
+}
+
+ZTEST(test_state_space, test_saturated_observer) {
+    Observer controller;
+    zassert_equal(controller.init(observerParams(0.1F)), 0);
+    float32_t x1 = 0.3F, x2 = -0.2F;
+    for (int k = 0; k < 6; k++) {
+        float32_t u = controller.calculateWithReturn({10.0F}, {x1})[0];
+        zexpect_within(u, 0.1F, 1e-6F, "the output is saturated");
+        x1 = x1 + x2 + 0.5F * u;
+        x2 = x2 + u;
+    }
+    // the observer is fed with the applied output: it still estimates the plant
+    zexpect_within(controller.getState()[0], x1, 1e-4F);
+    zexpect_within(controller.getState()[1], x2, 1e-4F);
+}
+
+ZTEST(test_state_space, test_bounds) {
+    ot::StateSpace<1, 2, 1, float32_t> controller;
+    ot::StateSpaceParams<1, 2, 1, float32_t> p{};
+    p.Ts = 1.0F;
+    p.Dr[0][0] = 1.0F;
+    p.Dr[1][0] = -1.0F;
+    p.lower_bound = {-1.0F, -2.0F};
+    p.upper_bound = {1.0F, 2.0F};
+    zassert_equal(controller.init(p), 0);
+    std::array<float32_t, 2> u = controller.calculateWithReturn({5.0F}, {0.0F});
+    zexpect_equal(u[0], 1.0F);
+    zexpect_equal(u[1], -2.0F);
+    controller.setBounds({-5.0F, 1.0F}, {5.0F, 0.0F});
+    u = controller.calculateWithReturn({3.0F}, {0.0F});
+    zexpect_equal(u[0], 1.0F, "invalid bounds are ignored");
+    p.lower_bound = {2.0F, 0.0F};
+    zexpect_equal(controller.init(p), -EINVAL);
+    p.lower_bound = {-1.0F, -2.0F};
+    zexpect_is_null(controller.checkParams(p));
+    p.Ts = 0.0F;
+    zexpect_not_null(controller.checkParams(p));
+    zexpect_equal(controller.init(p), -EINVAL);
+}
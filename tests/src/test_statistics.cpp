@@ -0,0 +1,98 @@
+#include <math.h>
+#include <zephyr/ztest.h>
+#include <zephyr/logging/log.h>
+#include <statistics.h>
+
+LOG_MODULE_DECLARE(test_control);
+
+ZTEST_SUITE(test_statistics, NULL, NULL, NULL, NULL, NULL);
+
+static ot_scalar_t window[1000];
+
+/**
+ * @brief uniform noise in [0, 1[ from a linear congruential generator.
+ */
+static ot_scalar_t noise(uint32_t &seed) {
+    seed = seed * 1664525U + 1013904223U;
+    return (seed >> 8) * (1.0F / 16777216.0F);
+}
+
+ZTEST(test_statistics, test_moving_average) {
+    MovingAverage average;
+    zassert_equal(average.init(window, 4), 0);
+    zexpect_within(average.calculateWithReturn(4.0F), 1.0F, 1e-6F, "missing samples are 0");
+    average.calculateWithReturn(4.0F);
+    average.calculateWithReturn(4.0F);
+    zexpect_within(average.calculateWithReturn(4.0F), 4.0F, 1e-6F);
+    zexpect_within(average.calculateWithReturn(8.0F), 5.0F, 1e-6F);
+    average.reset();
+    zexpect_within(average.getMean(), 0.0F, 1e-6F);
+}
+
+ZTEST(test_statistics, test_no_drift) {
+    // large offset and small variations: a running sum alone would drift
+    MovingAverage average;
+    zassert_equal(average.init(window, 1000), 0);
+    uint32_t seed = 1;
+    for (uint32_t k = 0; k < 2000000; k++) {
+        average.calculateWithReturn(1000.0F + noise(seed));
+    }
+    double exact = 0.0;
+    for (uint16_t k = 0; k < 1000; k++) {
+        exact += window[k];
+    }
+    // the last renewal was at the end of a window
+    zexpect_within(average.getMean(), (ot_scalar_t)(exact / 1000.0), 1e-3F);
+}
+
+ZTEST(test_statistics, test_period_rms) {
+    // one period of 50 Hz at 20 kHz
+    MovingStatistics statistics;
+    zassert_equal(statistics.init(window, 400), 0);
+    const ot_scalar_t Ts = 50e-6F;
+    for (uint32_t k = 0; k < 400000; k++) {
+        statistics.calculateWithReturn(1.0F + 325.0F * sinf(2.0F * PI * 50.0F * Ts * (k % 400)));
+        if (k > 400 && k % 997 == 0) {
+            zassert_within(statistics.getMean(), 1.0F, 1e-2F, "k = %u", k);
+            zassert_within(statistics.getRms(), sqrtf(1.0F + 325.0F * 325.0F / 2.0F), 1e-2F, "k = %u", k);
+            zassert_within(statistics.getVariance(), 325.0F * 325.0F / 2.0F, 20.0F, "k = %u", k);
+        }
+    }
+}
+
+ZTEST(test_statistics, test_offset_variance) {
+    // 1 V of ripple on a 400 V bus: E[x²] - mean² would lose every digit of
+    // the variance in float32_t
+    static float32_t samples[400];
+    ot::MovingStatistics<float32_t> statistics;
+    zassert_equal(statistics.init(samples, 400), 0);
+    for (uint32_t k = 0; k < 40000; k++) {
+        statistics.calculateWithReturn(400.0F + sinf(2.0F * PI * (k % 400) / 400.0F));
+        if (k > 400 && k % 997 == 0) {
+            zassert_within(statistics.getMean(), 400.0F, 1e-3F, "k = %u", k);
+            zassert_within(statistics.getVariance(), 0.5F, 1e-3F, "k = %u", k);
+            zassert_within(statistics.getRms(), sqrtf(400.0F * 400.0F + 0.5F), 1e-3F, "k = %u", k);
+        }
+    }
+}
+
+ZTEST(test_statistics, test_exponential) {
+    ExponentialStatistics statistics;
+    zassert_equal(statistics.init(1e-4F, 1e-2F), 0);
+    for (int k = 0; k < 20000; k++) {
+        // square wave: mean 2, variance 1
+        statistics.calculateWithReturn(k % 2 ? 3.0F : 1.0F);
+    }
+    zexpect_within(statistics.getMean(), 2.0F, 2e-2F);
+    zexpect_within(statistics.getVariance(), 1.0F, 2e-2F);
+    zexpect_within(statistics.getRms(), sqrtf(5.0F), 2e-2F);
+    zexpect_equal(statistics.init(1e-4F, 0.0F), -EINVAL);
+}
+
+ZTEST(test_statistics, test_invalid_window) {
+    MovingAverage average;
+    MovingStatistics statistics;
+    zexpect_equal(average.init(nullptr, 10), -EINVAL);
+    zexpect_equal(average.init(window, 0), -EINVAL);
+    zexpect_equal(statistics.init(nullptr, 10), -EINVAL);
+}
@@ -0,0 +1,126 @@
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <triple_buffer.h>
+#include <pid.h>
+#include <pr.h>
+
+LOG_MODULE_DECLARE(test_control);
+
+ZTEST_SUITE(test_triple_buffer, NULL, NULL, NULL, NULL, NULL);
+
+#define STRESS_STACK_SIZE 1024
+#define STRESS_VERSIONS 20000
+
+struct versioned_set {
+    uint32_t values[8];
+};
+
+static ot::TripleBuffer<versioned_set> stress_buffer;
+static std::atomic<bool> stress_done;
+K_THREAD_STACK_DEFINE(stress_stack, STRESS_STACK_SIZE);
+static struct k_thread stress_thread;
+
+/* writer: every field of a published set holds its version. */
+static void stress_writer(void *, void *, void *) {
+    for (uint32_t version = 1; version <= STRESS_VERSIONS; version++) {
+        versioned_set &set = stress_buffer.edit();
+        for (int k = 0; k < 8; k++) {
+            set.values[k] = version;
+        }
+        stress_buffer.publish();
+    }
+    stress_done = true;
+}
+
+ZTEST(test_triple_buffer, test_no_torn_read) {
+    stress_buffer.init(versioned_set{});
+    stress_done = false;
+    k_thread_create(&stress_thread, stress_stack, K_THREAD_STACK_SIZEOF(stress_stack),
+                    stress_writer, NULL, NULL, NULL,
+                    K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+    uint32_t torn = 0;
+    uint32_t previous = 0;
+    uint32_t backward = 0;
+    while (!stress_done) {
+        const versioned_set &set = stress_buffer.get(stress_buffer.acquire());
+        uint32_t first = set.values[0];
+        for (int k = 1; k < 8; k++) {
+            if (set.values[k] != first) {
+                torn++;
+            }
+        }
+        stress_buffer.release();
+        if (first < previous) {
+            backward++;
+        }
+        previous = first;
+        k_yield();
+    }
+    k_thread_join(&stress_thread, K_FOREVER);
+    zassert_equal(torn, 0, "%u torn reads", torn);
+    zassert_equal(backward, 0, "%u versions read backward", backward);
+    zassert_equal(stress_buffer.active().values[0], STRESS_VERSIONS);
+}
+
+ZTEST(test_triple_buffer, test_publish_while_reading) {
+    // a writer preempting a reader which holds a set never waits for it,
+    // e.g. a high priority thread retuning a controller used by a low one
+    ot::TripleBuffer<versioned_set> buffer;
+    buffer.init(versioned_set{});
+    const versioned_set &read = buffer.get(buffer.acquire());
+    for (uint32_t version = 1; version <= 10; version++) {
+        versioned_set &set = buffer.edit();
+        for (int k = 0; k < 8; k++) {
+            set.values[k] = version;
+        }
+        buffer.publish();
+        zassert_equal(read.values[0], 0, "the set being read is not modified");
+    }
+    buffer.release();
+    zassert_equal(buffer.get(buffer.acquire()).values[7], 10);
+    buffer.release();
+    zassert_equal(buffer.active().values[7], 10);
+}
+
+ZTEST(test_triple_buffer, test_pid_retune) {
+    float32_t Ts = 100e-6F;
+    Pid pid(PidParams(Ts, 1.0F, 1e-3F, 0.0F, 1.0F, -10.0F, 10.0F));
+    pid.reset(0.0F);
+    for (int k = 0; k < 10; k++) {
+        pid.calculateWithReturn(1.0F, 0.0F);
+    }
+    /* bumpless: the integral term is kept across a change of Ti. */
+    float32_t before = pid.calculateWithReturn(0.0F, 0.0F);
+    zassert_equal(pid.setParams(PidParams(Ts, 1.0F, 2e-3F, 0.0F, 1.0F, -10.0F, 10.0F)), 0);
+    float32_t after = pid.calculateWithReturn(0.0F, 0.0F);
+    zexpect_within(after, before, 1e-6F, "after = %f, before = %f", after, before);
+    zassert_equal(pid.setParams(PidParams(Ts, 1.0F, 2e-3F, 0.0F, 1.0F, 10.0F, -10.0F)), -EINVAL);
+    pid.setBounds(-0.5F, 0.5F);
+    zexpect_equal(pid.calculateWithReturn(10.0F, 0.0F), 0.5F);
+    // the bounds of the base class follow
+    zexpect_equal(pid.saturate(10.0F), 0.5F);
+    zexpect_equal(pid.saturate(-10.0F), -0.5F);
+    zassert_equal(pid.setParams(PidParams(Ts, 1.0F, 2e-3F, 0.0F, 1.0F, -2.0F, 2.0F)), 0);
+    zexpect_equal(pid.saturate(10.0F), 2.0F);
+}
+
+ZTEST(test_triple_buffer, test_pr_retune) {
+    float32_t Ts = 100e-6F;
+    float32_t w0 = 2.0F * PI * 50.0F;
+    Pr pr(PrParams(Ts, 0.0F, 100.0F, w0, 0.0F, -10.0F, 10.0F));
+    Pr reference;
+    reference.init(PrParams(Ts, 0.0F, 100.0F, w0 * 1.01F, 0.0F, -10.0F, 10.0F));
+    /* the resonator states are kept: from rest, setW0 gives the same output as init. */
+    pr.setW0(w0 * 1.01F);
+    for (int k = 0; k < 200; k++) {
+        float32_t e = ot_sin(w0 * Ts * k);
+        zexpect_within(pr.calculateWithReturn(e, 0.0F), reference.calculateWithReturn(e, 0.0F),
+                       1e-6F, "k = %d", k);
+    }
+    zassert_equal(pr.setParams(PrParams(Ts, 0.0F, 0.0F, w0, 0.0F, -10.0F, 10.0F)), -EINVAL);
+    pr.setBounds(-1.0F, 1.0F);
+    zexpect_equal(pr.saturate(10.0F), 1.0F);
+    zassert_equal(pr.setParams(PrParams(Ts, 0.0F, 100.0F, w0, 0.0F, -3.0F, 3.0F)), 0);
+    zexpect_equal(pr.saturate(-10.0F), -3.0F);
+}